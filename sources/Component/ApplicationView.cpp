@@ -13,6 +13,7 @@
 #include "System.h"
 #include "Application.h"
 #include "Container.h"
+#include "NativeCompiler.h"
 #include "NodeView.h"
 #include "File.h"
 #include "Log.h"
@@ -433,6 +434,46 @@ bool ApplicationView::draw()
 
 					ImGui::Separator();
 
+					if (auto file = application->getCurrentFile())
+					{
+						if (ImGui::BeginMenu("Evaluation"))
+						{
+							auto container = file->getInnerContainer();
+							auto mode      = container->getEvaluationMode();
+
+							if (ImGui::MenuItem("Sequential", "", mode == Container::EvaluationMode::Sequential))
+								container->setEvaluationMode(Container::EvaluationMode::Sequential);
+
+							if (ImGui::MenuItem("Parallel", "", mode == Container::EvaluationMode::Parallel))
+								container->setEvaluationMode(Container::EvaluationMode::Parallel);
+
+							if (ImGui::MenuItem("Compiled", "", mode == Container::EvaluationMode::Compiled))
+								container->setEvaluationMode(Container::EvaluationMode::Compiled);
+
+							if (ImGui::MenuItem("Native", "", mode == Container::EvaluationMode::Native, NativeCompiler::IsSupported()))
+								container->setEvaluationMode(Container::EvaluationMode::Native);
+
+							ImGui::Separator();
+
+							if (ImGui::MenuItem("Demand driven", "", container->isDemandDriven()))
+								container->setDemandDriven(!container->isDemandDriven());
+
+
+							if (ImGui::MenuItem("Optimize graph", "", file->isOptimized()))
+							{
+								file->setOptimized(!file->isOptimized());
+								file->evaluateSelectedExpression();
+							}
+
+							ImGui::Separator();
+
+							auto& cache = file->getParseCache();
+							ImGui::TextDisabled("Parse cache: %zu hits, %zu misses", cache.getHits(), cache.getMisses());
+
+							ImGui::EndMenu();
+						}
+					}
+
 					if ( ImGui::BeginMenu("Verbosity Level") )
                     {
                         if( ImGui::MenuItem("Normal (0)", "", Log::GetVerbosityLevel() == 0u ) )
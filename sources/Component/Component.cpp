@@ -0,0 +1,56 @@
+#include "Component.h"
+#include "ComputeBase.h"
+#include "ComputeFunction.h"
+#include "ComputeBinaryOperation.h"
+#include "ComputeUnaryOperation.h"
+#include "DataAccess.h"
+#include "History.h"
+#include "View.h"
+#include "NodeView.h"
+#include "WireView.h"
+#include "ContainerView.h"
+#include "FileView.h"
+#include "ApplicationView.h"
+
+using namespace Nodable;
+
+/* For each Component type id, its class and the ids it can be accessed with (its own and its base classes ones) */
+struct ComponentTypeTable
+{
+	std::array<mirror::Class*, Component::TypeCount>       classes;
+	std::array<std::vector<size_t>, Component::TypeCount>  ids;
+};
+
+template<typename... Ts>
+static ComponentTypeTable MakeComponentTypeTable(TypeList<Ts...>)
+{
+	ComponentTypeTable table;
+	table.classes = { Ts::GetClass()... };
+
+	for (size_t i = 0; i < Component::TypeCount; i++)
+	{
+		table.ids[i].push_back(i);
+
+		for (size_t base = 0; base < Component::TypeCount; base++)
+		{
+			if (base != i && table.classes[i]->isChildOf(table.classes[base], false))
+				table.ids[i].push_back(base);
+		}
+	}
+
+	return table;
+}
+
+const std::vector<size_t>& Component::GetTypeIds(const mirror::Class* _class)
+{
+	static const ComponentTypeTable s_table = MakeComponentTypeTable(ComponentTypes());
+
+	for (size_t i = 0; i < TypeCount; i++)
+	{
+		if (s_table.classes[i] == _class)
+			return s_table.ids[i];
+	}
+
+	NODABLE_ASSERT(false); // the class is missing in ComponentTypes
+	return s_table.ids[TypeId<Component>()];
+}
@@ -5,9 +5,51 @@
 #include "Compound.h"
 
 #include <mirror.h>
+#include <array>
+#include <type_traits>
 
 namespace Nodable{
 
+	/* A compile-time list of types */
+	template<typename... Ts>
+	struct TypeList {};
+
+	/* Index of T in a TypeList (does not compile if T is not in the list) */
+	template<typename T, typename List>
+	struct TypeIndex;
+
+	template<typename T, typename... Ts>
+	struct TypeIndex<T, TypeList<T, Ts...>>: std::integral_constant<size_t, 0> {};
+
+	template<typename T, typename U, typename... Ts>
+	struct TypeIndex<T, TypeList<U, Ts...>>: std::integral_constant<size_t, 1 + TypeIndex<T, TypeList<Ts...>>::value> {};
+
+	/* Number of types in a TypeList */
+	template<typename List>
+	struct TypeListSize;
+
+	template<typename... Ts>
+	struct TypeListSize<TypeList<Ts...>>: std::integral_constant<size_t, sizeof...(Ts)> {};
+
+	/*
+		All Component types, the index of a type in this list is its id (cf. Component::TypeId<T>()).
+		A new Component class must be added here (and its header included in Component.cpp).
+	*/
+	using ComponentTypes = TypeList<
+		Component,
+		ComputeBase,
+		ComputeFunction,
+		ComputeBinaryOperation,
+		ComputeUnaryOperation,
+		DataAccess,
+		History,
+		View,
+		NodeView,
+		WireView,
+		ContainerView,
+		FileView,
+		ApplicationView>;
+
 	class Component: public Object
 	{
 	public:
@@ -19,10 +61,21 @@ namespace Nodable{
 		void       setOwner(Node* _entity){ owner = _entity; }
 		Node* getOwner()const{return owner;}
 
+		/* Number of Component types (cf. ComponentTypes) */
+		static constexpr size_t TypeCount = TypeListSize<ComponentTypes>::value;
+
+		/* Get the id of a Component type, known at compile time */
+		template<typename T>
+		static constexpr size_t TypeId() { return TypeIndex<T, ComponentTypes>::value; }
+
+		/* Get the ids of a Component class and all its base classes (computed once).
+		   A Node stores a Component at each of these ids (cf. Node::addComponent()). */
+		static const std::vector<size_t>& GetTypeIds(const mirror::Class* _class);
+
 	private:
 		Node* owner = nullptr;
 		MIRROR_CLASS(Component)(
 			MIRROR_PARENT(Object);
 		);
 	};
-}
\ No newline at end of file
+}
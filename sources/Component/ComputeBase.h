@@ -11,6 +11,7 @@ namespace Nodable
 		virtual ~ComputeBase() {};
 		virtual void updateResultSourceExpression() const = 0;
 		void         setResult(Member* _value) { result = _value; };
+		Member*      getResult()const { return result; };
 	protected:
 		const Language* language;
 		Member* result = nullptr;
@@ -14,6 +14,8 @@ Nodable::ComputeBinaryOperation::ComputeBinaryOperation(
 	ComputeFunction(_operator , _language),
 	ope(_operator)
 {
+	// an operation is cheaper than looking for its arguments in the memo
+	setMemoEnabled(false);
 }
 
 void ComputeBinaryOperation::setLValue(Member* _value){
@@ -1,33 +1,118 @@
 #include "ComputeFunction.h"
 #include "Log.h"
+#include "Member.h"
+
+#include <algorithm>
 
 using namespace Nodable;
 
 ComputeFunction::ComputeFunction(const Function* _function, const Language* _language) :
 	ComputeBase(_language),
-	function(_function)
+	function(_function),
+	memoEnabled(_function->pure)
 {
-	size_t i = 0;
-	while (args.size() < _function->signature.getArgs().size())
+	for (const auto& arg : _function->signature.getArgs())
+	{
 		args.push_back(nullptr);
+		argTypes.push_back(_language->tokenTypeToType(arg.type));
+	}
 }
 
 bool ComputeFunction::update()
 {
 
-	if (function->implementation == NULL) {
+	if (!function->isCallable()) {
 		LOG_ERROR(0u, "Unable to find %s's nativeFunction.\n", language->serialize(function->signature).c_str());
 		return false;
 	}
 
-	if (function->implementation(result, args))
+	// a hand-made connection (or an undefined variable) can bring an argument of another type
+	if (function->thunk != nullptr && !convertArgs()) {
+		LOG_WARNING(0u, "Unable to evaluate %s, an argument is missing or can't be converted.\n", language->serialize(function->signature).c_str());
+		return false;
+	}
+
+	if (memoEnabled && recall())
+		return true;
+
+	if (function->call(result, args))
 		LOG_MESSAGE(0u, "Evaluation of %s's native function failed !\n", language->serialize(function->signature).c_str());
+	else if (memoEnabled)
+		memorize();
+
+	return true;
+}
+
+bool ComputeFunction::convertArgs()
+{
+	for (size_t i = 0; i < args.size(); i++)
+	{
+		auto arg = args[i];
+		if (arg == nullptr)
+			return false;
+
+		if (arg->isType(argTypes[i]))
+			continue;
+
+		// the value is read again from the input member before the next update
+		const auto& data = arg->getData();
+		switch (argTypes[i])
+		{
+			case Type::Double:  arg->set((double)data);      break;
+			case Type::Boolean: arg->set((bool)data);        break;
+			case Type::String:  arg->set((std::string)data); break;
+			case Type::Int64:   arg->set((int64_t)data);     break;
+			case Type::Float32: arg->setFloat32((float)data); break;
+			case Type::Vec2:    arg->set((Vec<2>)data);      break;
+			case Type::Vec3:    arg->set((Vec<3>)data);      break;
+			case Type::Vec4:    arg->set((Vec<4>)data);      break;
+			default:            return false;
+		}
+	}
+	return true;
+}
 
-	this->updateResultSourceExpression();
+bool ComputeFunction::recall()
+{
+	auto found = std::find_if(memo.begin(), memo.end(), [&](const MemoEntry& _entry) {
+		for (size_t i = 0; i < args.size(); i++)
+		{
+			if (args[i] == nullptr || _entry.args[i] != args[i]->getData())
+				return false;
+		}
+		return true;
+	});
+
+	if (found == memo.end())
+	{
+		memoMisses++;
+		return false;
+	}
 
+	memoHits++;
+	result->set(found->result);
+	std::rotate(memo.begin(), found, found + 1);
 	return true;
 }
 
+void ComputeFunction::memorize()
+{
+	if (std::find(args.begin(), args.end(), nullptr) != args.end())
+		return;
+
+	// reuse the oldest entry when full
+	if (memo.size() < MemoCapacity)
+		memo.emplace_back();
+
+	auto& entry = memo.back();
+	entry.args.resize(args.size());
+	for (size_t i = 0; i < args.size(); i++)
+		entry.args[i] = args[i]->getData();
+	entry.result = result->getData();
+
+	std::rotate(memo.begin(), memo.end() - 1, memo.end());
+}
+
 void ComputeFunction::updateResultSourceExpression() const
 {
 	std::string expr = language->serialize(function->signature, args);
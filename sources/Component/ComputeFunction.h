@@ -1,12 +1,18 @@
 #pragma once
 
+#include <vector>
+
 #include "Nodable.h"
 #include "ComputeBase.h"
+#include "Variant.h"
 
 namespace Nodable
 {
 	/**
 	  * ComputeFunction is a class able to eval a function (using its prototype and a language)
+	  *
+	  * Results of the last calls of a pure function are kept (cf. Function::pure), calling it again
+	  * with the same argument values (ex: after an undo) sets the result without calling the function.
 	  */
 	class ComputeFunction : public ComputeBase {
 	public:
@@ -14,12 +20,45 @@ namespace Nodable
 		~ComputeFunction() {};
 
 		void setArg(size_t _index, Member* _value) { args[_index] = _value; };
+		const std::vector<Member*>& getArgs()const { return args; };
+		const Function* getFunction()const { return function; };
 		bool update()override;
 		void updateResultSourceExpression() const override;
+
+		/* Memo of the last MemoCapacity calls, enabled for pure functions (operators are cheaper to call) */
+		void   setMemoEnabled(bool _enabled) { memoEnabled = _enabled; memo.clear(); }
+		bool   isMemoEnabled()const { return memoEnabled; }
+		size_t getMemoHits()const { return memoHits; }
+		size_t getMemoMisses()const { return memoMisses; }
+
+		static constexpr size_t MemoCapacity = 8;
 	protected:
 		std::vector<Member*> args;
 		const Function* function;
 
+	private:
+		/* Convert the arguments not having the type of the signature (native functions read them without conversion).
+		   Return false if an argument is missing or can't be converted. */
+		bool convertArgs();
+
+		/* Set the result from the memo if the arguments were seen, return false otherwise */
+		bool recall();
+
+		/* Store the arguments and the result of the last call (the oldest entry is dropped if full) */
+		void memorize();
+
+		struct MemoEntry
+		{
+			std::vector<Variant> args;
+			Variant              result;
+		};
+
+		std::vector<Type>      argTypes; /* from the signature */
+		std::vector<MemoEntry> memo; /* most recently used first */
+		bool                   memoEnabled;
+		size_t                 memoHits   = 0;
+		size_t                 memoMisses = 0;
+
 		MIRROR_CLASS(ComputeFunction)(
 			MIRROR_PARENT(ComputeBase)
 			);
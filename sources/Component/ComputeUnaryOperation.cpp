@@ -15,6 +15,8 @@ Nodable::ComputeUnaryOperation::ComputeUnaryOperation(
 	ComputeFunction(_operator, _language),
 	ope(_operator)
 {
+	// an operation is cheaper than looking for its arguments in the memo
+	setMemoEnabled(false);
 }
 
 void ComputeUnaryOperation::setLValue(Member* _value) {
@@ -10,9 +10,14 @@
 #include "DataAccess.h"
 #include <cstring>      // for strcmp
 #include <algorithm>    // for std::find_if
+#include <unordered_map>
+#include <unordered_set>
 #include "NodeView.h"
 #include "Application.h"
-#include "NodeTraversal.h"
+#include "TaskScheduler.h"
+#include "Program.h"
+#include "Compiler.h"
+#include "NativeCompiler.h"
 #include <IconFontCppHeaders/IconsFontAwesome5.h>
 
 using namespace Nodable;
@@ -34,6 +39,9 @@ void Container::clear()
 
 	LOG_MESSAGE(1u, "=================== Container::clear() ==================\n");
 
+	// all variables are removed, no need to look for a homonym of each one (cf. remove())
+	variablesByName.clear();
+
 	auto nodeIndex = nodes.size();
 
 	while ( nodeIndex > 0)
@@ -42,10 +50,13 @@ void Container::clear()
 	    auto node = nodes.at(nodeIndex);
         LOG_MESSAGE(1u, "remove and delete: %s \n", node->getLabel() );
         remove(node);
-        delete node;
+        Arena::Delete(node);
 	}
     nodes.resize(0);
 
+    // All memory is available again, the next nodes will be allocated contiguously
+    arena.reset();
+
     LOG_MESSAGE(1u, "===================================================\n");
 
 
@@ -54,6 +65,10 @@ void Container::clear()
 
 UpdateResult Container::update()
 {
+    // the graph may be incomplete
+    if (transactionDepth != 0)
+        return UpdateResult::SuccessWithoutChanges;
+
     /*
         1 - Delete flagged Nodes
     */
@@ -68,67 +83,231 @@ UpdateResult Container::update()
             if (node->needsToBeDeleted())
             {
                 remove(node);
-                delete node;
+                Arena::Delete(node);
             }
 
         }
     }
 
 	/*
-	    2 - Update all Nodes
+	    2 - Update dirty Nodes following the topological order (inputs first)
     */
-    size_t updatedNodesCount(0);
-    auto result = Result::Success;
+    size_t updatedNodesCount;
+    bool        structureChanged = scheduleOutdated;
+    const auto& nodesToEvaluate  = getSchedule();
+
+    // the expressions of the nodes about to be evaluated (all of them if the wiring has changed) are rebuilt afterwards
+    outdatedSourceExpressions.resize(nodesToEvaluate.size());
+    for (size_t i = 0; i < nodesToEvaluate.size(); i++)
+        outdatedSourceExpressions[i] = structureChanged || nodesToEvaluate[i]->isDirty();
+
+    if (evaluationMode == EvaluationMode::Parallel && !scheduleHasCycle && nodesToEvaluate.size() > 1)
     {
-        auto it = nodes.begin();
+        updatedNodesCount = evaluateInParallel();
+    }
+    else if ((evaluationMode == EvaluationMode::Compiled || evaluationMode == EvaluationMode::Native) && getProgram() != nullptr)
+    {
+        updatedNodesCount = evaluateProgram();
+    }
+    else
+    {
+        updatedNodesCount = evaluateSequentially();
+    }
+
+    updateSourceExpressions();
+
+	if( updatedNodesCount > 0 && NodeView::GetSelected() != nullptr)
+    {
+	    return UpdateResult::SuccessWithChanges;
+    }
+	else
+    {
+	    return UpdateResult::SuccessWithoutChanges;
+    }
+
+}
+
+size_t Container::evaluateSequentially()
+{
+    size_t updatedNodesCount(0);
+    std::vector<Variant> outputs;
 
-        while (it < nodes.end() && result != Result::Failure)
+    for (auto node : schedule)
+    {
+        if (node->isDirty())
         {
-            auto node = *it;
+            updatedNodesCount++;
+            evaluate(node, outputs);
+        }
+    }
 
-            if (node && node->isDirty())
-            {
-                updatedNodesCount++;
-                result = NodeTraversal::Update(node);
-            }
+    return updatedNodesCount;
+}
+
+void Container::updateSourceExpressions()
+{
+    // an expression reads its inputs' expressions, which may change even if their values do not (ex: "2 > 0" to "3 > 0")
+    for (size_t i = 0; i < schedule.size(); i++)
+    {
+        if (!outdatedSourceExpressions[i])
+            continue;
+
+        if (auto compute = schedule[i]->getComponent<ComputeBase>())
+            compute->updateResultSourceExpression();
+
+        for (auto successor : successors[i])
+            outdatedSourceExpressions[successor] = true;
+    }
+}
 
-            ++it;
+void Container::evaluate(Node* _node, std::vector<Variant>& _outputs)
+{
+    // Store the output values to compare them after the update
+    _outputs.clear();
+    for (auto member : _node->getMembers())
+    {
+        if (member->allowsConnection(Way_Out))
+            _outputs.push_back(member->getData());
+    }
+
+    _node->updateInputs();
+    _node->update();
+    _node->setDirty(false);
+
+    // Readers are evaluated only if the value they read has changed (they come later in the schedule)
+    auto output = _outputs.begin();
+    for (auto member : _node->getMembers())
+    {
+        if (member->allowsConnection(Way_Out))
+        {
+            if (member->getData() != *output)
+                _node->setReadersDirty(member);
+            output++;
         }
     }
+}
+
+size_t Container::evaluateProgram()
+{
+    size_t updatedNodesCount = std::count_if(schedule.begin(), schedule.end(), [](const Node* _node) { return _node->isDirty(); });
+    if (updatedNodesCount == 0)
+        return 0;
 
-	if( result != Result::Failure &&
-	    updatedNodesCount > 0 && NodeView::GetSelected() != nullptr)
+    // A Member type has changed since compilation (ex: a variable set with a string), the program needs to be compiled again.
+    if (!program->run())
     {
-	    return UpdateResult::SuccessWithChanges;
+        programOutdated = true;
+        return evaluateSequentially();
     }
-	else
+
+    // only a program run several times unchanged is worth the time of a C++ compilation
+    if (evaluationMode == EvaluationMode::Native && ++programRunCount == NativeCompilationRuns && program->getInstructionCount() != 0)
+        nativeCode = NativeCompiler().compileAsync(*program);
+
+    for (auto node : schedule)
+        node->setDirty(false);
+
+    return updatedNodesCount;
+}
+
+size_t Container::evaluateInParallel()
+{
+    // Nothing to do ? We avoid waking up the workers.
+    auto anyDirty = std::any_of(schedule.begin(), schedule.end(), [](const Node* _node) { return _node->isDirty(); });
+    if (!anyDirty)
+        return 0;
+
+    std::atomic<size_t> updatedNodesCount(0);
+    auto& scheduler = TaskScheduler::Shared();
+
+    for (size_t i = 0; i < schedule.size(); i++)
+        pendingInputCounts[i] = inputCounts[i];
+
+    // Start from the nodes without inputs, the others will be released by their inputs.
+    for (size_t i = 0; i < schedule.size(); i++)
     {
-	    return UpdateResult::SuccessWithoutChanges;
+        if (inputCounts[i] == 0)
+            scheduler.spawn([this, i, &updatedNodesCount] { evaluateFrom(i, updatedNodesCount); });
     }
 
+    scheduler.wait();
+
+    return updatedNodesCount;
+}
+
+void Container::evaluateFrom(size_t _index, std::atomic<size_t>& _updatedNodesCount)
+{
+    auto& scheduler = TaskScheduler::Shared();
+    std::vector<size_t> ready{ _index };
+    std::vector<Variant> outputs;
+
+    while (!ready.empty())
+    {
+        auto index = ready.back();
+        ready.pop_back();
+
+        auto node = schedule[index];
+        if (node->isDirty())
+        {
+            _updatedNodesCount++;
+            evaluate(node, outputs);
+        }
+
+        // Release the successors, the last input evaluated is in charge of them.
+        // Clean nodes and the first released node continue on this thread, other dirty ones become new tasks.
+        for (auto successor : successors[index])
+        {
+            if (--pendingInputCounts[successor] == 0)
+            {
+                if (ready.empty() || !schedule[successor]->isDirty())
+                    ready.push_back(successor);
+                else
+                    scheduler.spawn([this, successor, &_updatedNodesCount] { evaluateFrom(successor, _updatedNodesCount); });
+            }
+        }
+    }
 }
 
 void Container::add(Node* _node)
 {
 	this->nodes.push_back(_node);
 	_node->setParentContainer(this);
+	invalidateSchedule();
 }
 
 void Container::remove(Node* _node)
 {
     {
-        auto it = std::find(variables.begin(), variables.end(), _node);
-        if (it != variables.end())
+        // search from the end, the last created nodes are usually removed first (cf. clear())
+        auto it = std::find(variables.rbegin(), variables.rend(), _node);
+        if (it != variables.rend())
         {
-            variables.erase(it);
+            auto name   = std::string((*it)->getName());
+            auto member = (*it)->getMember();
+            variables.erase(std::next(it).base());
+
+            // the variable can't be bound anymore (cf. bindColumn())
+            columns.erase(std::remove_if(columns.begin(), columns.end(), [&](const Program::Column& _column) {
+                return _column.member == member;
+            }), columns.end());
+
+            // another variable with the same name (if any) can now be found
+            auto found = variablesByName.find(name);
+            if (found != variablesByName.end() && found->second == _node)
+            {
+                variablesByName.erase(found);
+                auto other = std::find_if(variables.begin(), variables.end(), [&](const Variable* _variable) { return name == _variable->getName(); });
+                if (other != variables.end())
+                    variablesByName.emplace(name, *other);
+            }
         }
     }
 
     {
-        auto it = std::find(nodes.begin(), nodes.end(), _node);
-        if (it != nodes.end())
+        auto it = std::find(nodes.rbegin(), nodes.rend(), _node);
+        if (it != nodes.rend())
         {
-            nodes.erase(it);
+            nodes.erase(std::next(it).base());
         }
     }
 
@@ -136,20 +315,292 @@ void Container::remove(Node* _node)
     {
         this->resultNode = nullptr;
     }
+
+    pendingDirtyNodes.erase(_node);
+
+    watchedMembers.erase(std::remove_if(watchedMembers.begin(), watchedMembers.end(), [&](const Member* _member) {
+        return _member->getOwner() == _node;
+    }), watchedMembers.end());
+
+    invalidateSchedule();
 }
 
-Variable* Container::findVariable(std::string _name)
+const std::vector<Node*>& Container::getSchedule()
 {
-	Variable* result = nullptr;
+    if (scheduleOutdated)
+    {
+        updateSchedule();
+        scheduleOutdated = false;
+    }
+    return schedule;
+}
+
+void Container::updateSchedule()
+{
+    LOG_MESSAGE(1u, "Container::updateSchedule() (%i nodes)\n", (int)nodes.size());
+
+    schedule.clear();
+    schedule.reserve(nodes.size());
 
-	auto findFunction = [_name](const Variable* _variable ) -> bool
-	{
-		return strcmp(_variable->getName(), _name.c_str()) == 0;
-	};
+    /*
+        Kahn's algorithm: count the input wires coming from this container for each node,
+        then consume the nodes with no pending inputs.
+    */
+    std::unordered_map<Node*, size_t> pendingInputs;
+    pendingInputs.reserve(nodes.size());
+
+    for (auto node : nodes)
+    {
+        size_t count = 0;
+        for (auto wire : node->getWires())
+        {
+            auto sourceNode = static_cast<Node*>(wire->getSource()->getOwner());
+            if (wire->getTarget()->getOwner() == node && sourceNode->getParentContainer() == this)
+                count++;
+        }
+
+        pendingInputs[node] = count;
+        if (count == 0)
+            schedule.push_back(node);
+    }
+
+    for (size_t i = 0; i < schedule.size(); i++)
+    {
+        auto node = schedule[i];
+        for (auto wire : node->getWires())
+        {
+            auto targetNode = static_cast<Node*>(wire->getTarget()->getOwner());
+            if (wire->getSource()->getOwner() == node && targetNode->getParentContainer() == this)
+            {
+                if (--pendingInputs[targetNode] == 0)
+                    schedule.push_back(targetNode);
+            }
+        }
+    }
+
+    // Nodes involved in a cycle are never released, we append them to evaluate them anyway.
+    scheduleHasCycle = schedule.size() != nodes.size();
+    if (scheduleHasCycle)
+    {
+        LOG_WARNING(0u, "Container::updateSchedule(): cycle detected, %i node(s) will be evaluated in creation order.\n",
+                    (int)(nodes.size() - schedule.size()));
+
+        for (auto node : nodes)
+        {
+            if (pendingInputs[node] != 0)
+                schedule.push_back(node);
+        }
+    }
+
+    if (demandDriven)
+        keepDemandedNodes();
+
+    /*
+        Store the dependencies using schedule indices, parallel evaluation relies on them
+        to start a node only once all its inputs are evaluated.
+    */
+    std::unordered_map<Node*, size_t> scheduleIndex;
+    scheduleIndex.reserve(schedule.size());
+    for (size_t i = 0; i < schedule.size(); i++)
+        scheduleIndex[schedule[i]] = i;
+
+    successors.assign(schedule.size(), {});
+    inputCounts.assign(schedule.size(), 0);
+    pendingInputCounts = std::vector<std::atomic<size_t>>(schedule.size());
+
+    for (size_t i = 0; i < schedule.size(); i++)
+    {
+        auto node = schedule[i];
+        for (auto wire : node->getWires())
+        {
+            auto targetNode = static_cast<Node*>(wire->getTarget()->getOwner());
+            if (wire->getSource()->getOwner() == node && targetNode->getParentContainer() == this)
+            {
+                // a reader can be out of the schedule (cf. keepDemandedNodes())
+                auto found = scheduleIndex.find(targetNode);
+                if (found == scheduleIndex.end())
+                    continue;
+
+                successors[i].push_back(found->second);
+                inputCounts[found->second]++;
+            }
+        }
+    }
+}
+
+void Container::commitTransaction()
+{
+    NODABLE_ASSERT(transactionDepth != 0);
+    if (--transactionDepth != 0)
+        return;
+
+    for (auto node : pendingDirtyNodes)
+        node->setDirty();
+    pendingDirtyNodes.clear();
+
+    invalidateSchedule();
+}
+
+void Container::setDirty(Node* _node)
+{
+    if (transactionDepth != 0)
+        pendingDirtyNodes.insert(_node);
+    else
+        _node->setDirty();
+}
+
+void Container::keepDemandedNodes()
+{
+    // walk the wires upstream, from the result and the watched Members
+    std::unordered_set<Node*> demanded;
+    std::vector<Node*>        pending;
+
+    auto demand = [&](Node* _node) {
+        if (_node->getParentContainer() == this && demanded.insert(_node).second)
+            pending.push_back(_node);
+    };
+
+    if (resultNode != nullptr)
+        demand(resultNode);
+
+    for (auto member : watchedMembers)
+        demand(static_cast<Node*>(member->getOwner()));
+
+    while (!pending.empty())
+    {
+        auto node = pending.back();
+        pending.pop_back();
+
+        for (auto wire : node->getWires())
+        {
+            if (wire->getTarget()->getOwner() == node)
+                demand(static_cast<Node*>(wire->getSource()->getOwner()));
+        }
+    }
+
+    // the topological order is kept
+    schedule.erase(std::remove_if(schedule.begin(), schedule.end(), [&](Node* _node) {
+        return demanded.find(_node) == demanded.end();
+    }), schedule.end());
+
+    LOG_MESSAGE(1u, "Container::keepDemandedNodes() %i/%i nodes demanded\n", (int)schedule.size(), (int)nodes.size());
+}
+
+void Container::watch(Member* _member)
+{
+    if (std::find(watchedMembers.begin(), watchedMembers.end(), _member) == watchedMembers.end())
+    {
+        watchedMembers.push_back(_member);
+        invalidateSchedule();
+    }
+}
+
+void Container::unwatch(Member* _member)
+{
+    auto found = std::find(watchedMembers.begin(), watchedMembers.end(), _member);
+    if (found != watchedMembers.end())
+    {
+        watchedMembers.erase(found);
+        invalidateSchedule();
+    }
+}
+
+Program* Container::getProgram()
+{
+    if (programOutdated)
+    {
+        if (!program)
+            program = std::make_unique<Program>();
+
+        Compiler compiler(this);
+        if (!compiler.compile(*program))
+            program.reset();
+
+        // native code being built for the previous instructions is dropped
+        nativeCode      = {};
+        programRunCount = 0;
+        programOutdated = false;
+    }
+
+    // instructions are interpreted until the native code is ready, and on failure
+    if (nativeCode.valid() && nativeCode.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+    {
+        auto native = nativeCode.get();
+        if (program && native.code != nullptr)
+            program->setNativeCode(native.code, native.library);
+    }
+    return program.get();
+}
+
+void Container::bindColumn(Variable* _variable, const double* _values)
+{
+    bindColumn(_variable, Type::Double, _values);
+}
+
+void Container::bindColumn(Variable* _variable, const bool* _values)
+{
+    bindColumn(_variable, Type::Boolean, _values);
+}
+
+void Container::bindColumn(Variable* _variable, Type _type, const void* _values)
+{
+    auto member = _variable->getMember();
+
+    // the type must be known to compile the readers of the variable
+    if (!member->isType(_type))
+    {
+        member->setType(_type);
+        invalidateSchedule();
+    }
+
+    auto found = std::find_if(columns.begin(), columns.end(), [&](const Program::Column& _column) { return _column.member == member; });
+    if (found != columns.end())
+        *found = {member, _type, _values};
+    else
+        columns.push_back({member, _type, _values});
+}
+
+bool Container::evaluateBatch(size_t _rowCount, double* _results)
+{
+    return evaluateBatch(_rowCount, Type::Double, _results);
+}
+
+bool Container::evaluateBatch(size_t _rowCount, bool* _results)
+{
+    return evaluateBatch(_rowCount, Type::Boolean, _results);
+}
+
+bool Container::evaluateBatch(size_t _rowCount, Type _type, void* _results)
+{
+    if (resultNode == nullptr)
+        return false;
+
+    auto compiled = getProgram();
+    if (compiled == nullptr)
+    {
+        LOG_WARNING(0u, "Container::evaluateBatch(): the graph can't be compiled.\n");
+        return false;
+    }
+
+    return compiled->runBatch(columns, _rowCount, resultNode->getMember(), _type, _results);
+}
+
+void Container::setEvaluationMode(EvaluationMode _mode)
+{
+    // native code is dropped when compiling, then built again after NativeCompilationRuns runs (cf. evaluateProgram())
+    if ((_mode == EvaluationMode::Native) != (evaluationMode == EvaluationMode::Native))
+        programOutdated = true;
+
+    evaluationMode = _mode;
+}
+
+Variable* Container::findVariable(std::string_view _name)
+{
+	Variable* result = nullptr;
 
-	auto it = std::find_if(variables.begin(), variables.end(), findFunction);
-	if (it != variables.end()){
-		result = *it;
+	auto it = variablesByName.find(std::string(_name));
+	if (it != variablesByName.end()){
+		result = it->second;
 	}
 
 	return result;
@@ -158,7 +609,7 @@ Variable* Container::findVariable(std::string _name)
 Variable* Container::newResult()
 {
 	auto variable = newVariable(ICON_FA_SIGN_OUT_ALT " Result");
-	auto member = variable->get("value");
+	auto member = variable->getMember();
 	member->setConnectorWay(Way_In);                     // disable output because THIS node is the output !
 	resultNode = variable;
 
@@ -167,17 +618,18 @@ Variable* Container::newResult()
 
 Variable* Container::newVariable(std::string _name)
 {
-	auto node = new Variable();
+	auto node = arena.create<Variable>();
 	node->addComponent( new NodeView);
 	node->setName(_name.c_str());
 	this->variables.push_back(node);
+	this->variablesByName.emplace(_name, node);
 	this->add(node);
 	return node;
 }
 
 Variable* Container::newNumber(double _value)
 {
-	auto node = new Variable();
+	auto node = arena.create<Variable>();
 	node->addComponent( new NodeView);
 	node->set(_value);
 	this->add(node);
@@ -186,7 +638,7 @@ Variable* Container::newNumber(double _value)
 
 Variable* Container::newNumber(const char* _value)
 {
-	auto node = new Variable();
+	auto node = arena.create<Variable>();
 	node->addComponent( new NodeView);
 	node->set(std::stod(_value));
 	this->add(node);
@@ -195,7 +647,7 @@ Variable* Container::newNumber(const char* _value)
 
 Variable* Container::newString(const char* _value)
 {
-	auto node = new Variable();
+	auto node = arena.create<Variable>();
 	node->addComponent( new NodeView);
 	node->set(_value);
 	this->add(node);
@@ -221,9 +673,8 @@ Node* Container::newBinOp(const Operator* _operator)
 	//------------------
 
 	// Create a node with 2 inputs and 1 output
-	auto node = new Node();
 	auto signature = _operator->signature;
-	node->setLabel(signature.getLabel());
+	auto node = arena.create<Node>(signature.getLabel());
 	const auto args = signature.getArgs();
 	auto left   = node->add("lvalue", Visibility::Default, language->tokenTypeToType(args[0].type), Way_In);
 	auto right  = node->add("rvalue", Visibility::Default, language->tokenTypeToType(args[1].type), Way_In);
@@ -251,9 +702,8 @@ Node* Container::newUnaryOp(const Operator* _operator)
 	//------------------
 
 	// Create a node with 2 inputs and 1 output
-	auto node = new Node();
 	auto signature = _operator->signature;
-	node->setLabel(signature.getLabel());
+	auto node = arena.create<Node>(signature.getLabel());
 	const auto args = signature.getArgs();
 	auto left = node->add("lvalue", Visibility::Default, language->tokenTypeToType(args[0].type), Way_In);
 	auto result = node->add("result", Visibility::Default, language->tokenTypeToType(signature.getType()), Way_Out);
@@ -279,13 +729,12 @@ Node* Container::newFunction(const Function* _function) {
 	//------------------
 
 	// Create a node with 2 inputs and 1 output
-	auto node = new Node();
-	node->setLabel(ICON_FA_CODE " " + _function->signature.getIdentifier());
-	node->add("result", Visibility::Default, language->tokenTypeToType(_function->signature.getType()), Way_Out);
+	auto node = arena.create<Node>(ICON_FA_CODE " " + _function->signature.getIdentifier());
+	auto result = node->add("result", Visibility::Default, language->tokenTypeToType(_function->signature.getType()), Way_Out);
 
 	// Create ComputeBase binOpComponent and link values.
 	auto functionComponent = new ComputeFunction(_function, language);
-	functionComponent->setResult(node->get("result"));
+	functionComponent->setResult(result);
 
 	// Arguments
 	auto args = _function->signature.getArgs();
@@ -306,7 +755,7 @@ Node* Container::newFunction(const Function* _function) {
 
 Wire* Container::newWire()
 {
-	Wire* wire = new Wire();
+	Wire* wire = arena.create<Wire>();
 	wire->addComponent(new WireView);	
 	return wire;
 }
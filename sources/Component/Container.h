@@ -1,7 +1,13 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
+#include <memory>
+#include <future>
 #include <imgui/imgui.h>   // for ImVec2
 #include <mirror.h>
 
@@ -9,17 +15,29 @@
 #include "Component.h"
 #include "Node.h"
 #include "Language.h"
+#include "Arena.h"
+#include "Program.h"
+#include "NativeCompiler.h"
 
 namespace Nodable{
 
 	class Container: public Node {
 	public:
+		/* Distinguish the ways to evaluate the dirty nodes during update() */
+		enum class EvaluationMode
+		{
+			Sequential, /* one node after the other, following the schedule */
+			Parallel,   /* independent nodes are evaluated concurrently (cf. TaskScheduler) */
+			Compiled,   /* the whole graph is compiled into a Program (cf. Compiler), node by node evaluation otherwise */
+			Native      /* same as Compiled, and the Program is compiled to machine code (cf. NativeCompiler) when possible,
+			               on another thread once it has run NativeCompilationRuns times unchanged */
+		};
 
 		Container(const Language* _language);
 		virtual ~Container();
         UpdateResult                update() override;
 		void                      	clear();		
-		Variable* 	          		findVariable(std::string);
+		Variable* 	          		findVariable(std::string_view);
 		void                      	add(Node*);
 		void                      	remove(Node*);
 		size_t                    	getNodeCount()const;
@@ -27,6 +45,66 @@ namespace Nodable{
 		std::vector<Node*>& 	    getEntities(){return nodes;}
 		Variable*                   getResultVariable(){ return resultNode;}
 		void                        tryToRestoreResultNodePosition();
+
+		/* Edits made within a transaction (ex: the Parser building a graph) are applied at once on commit:
+		   connected nodes are flagged as dirty, the schedule is invalidated, and update() evaluates nothing
+		   until then (the graph may be incomplete). Transactions can be nested, the outermost commit applies. */
+		void                        beginTransaction(){ transactionDepth++; }
+		void                        commitTransaction();
+		bool                        isInTransaction()const{ return transactionDepth != 0; }
+
+		/* Begin a transaction and commit it when going out of scope */
+		class Transaction
+		{
+		public:
+			explicit Transaction(Container* _container): container(_container) { if (container) container->beginTransaction(); }
+			~Transaction() { if (container) container->commitTransaction(); }
+			Transaction(const Transaction&) = delete;
+			Transaction& operator=(const Transaction&) = delete;
+		private:
+			Container* container;
+		};
+
+		/* Flag _node as dirty, on commit if a transaction is open */
+		void                        setDirty(Node* _node);
+
+		/* Flag the evaluation schedule (and the compiled Program) as outdated, it will be rebuilt during the next update() */
+		void                        invalidateSchedule(){ scheduleOutdated = true; programOutdated = true; }
+
+		/* Get all nodes sorted topologically (inputs first), rebuilt only if the graph structure has changed */
+		const std::vector<Node*>&   getSchedule();
+
+		/* Get the graph compiled as a Program (recompiled only if the graph structure has changed).
+		   The native code is attached here once built (Native mode only).
+		   Return nullptr if the graph can't be compiled. */
+		Program*                    getProgram();
+
+		/* Successful runs of an unchanged Program before compiling it to native code (Native mode only) */
+		static constexpr size_t     NativeCompilationRuns = 8;
+
+		void                        setEvaluationMode(EvaluationMode _mode);
+		EvaluationMode              getEvaluationMode()const{ return evaluationMode; }
+
+		/* When demand driven, only the nodes the result variable or a watched Member depend on are evaluated,
+		   the others (ex: unused nodes) stay dirty until something reads them. */
+		void                        setDemandDriven(bool _enabled){ demandDriven = _enabled; invalidateSchedule(); }
+		bool                        isDemandDriven()const{ return demandDriven; }
+
+		/* Evaluate _member's node (and its inputs) even if the result does not depend on it (cf. setDemandDriven()) */
+		void                        watch(Member* _member);
+		void                        unwatch(Member* _member);
+
+		/* Bind a variable to a column of values (one per row) for evaluateBatch(), the variable type becomes the column's one.
+		   Values are not copied and must stay valid until the column is unbound or the variable removed. */
+		void                        bindColumn(Variable* _variable, const double* _values);
+		void                        bindColumn(Variable* _variable, const bool* _values);
+		void                        unbindColumns(){ columns.clear(); }
+
+		/* Evaluate the graph for _rowCount rows, variables bound to a column read a value per row (cf. bindColumn()),
+		   and write the result variable's value for each row into _results. Nodes are left unchanged.
+		   Return false if the graph can't be compiled (cf. getProgram()) or if the result is not of the _results type. */
+		bool                        evaluateBatch(size_t _rowCount, double* _results);
+		bool                        evaluateBatch(size_t _rowCount, bool* _results);
 		
 		/* node factory */
 		Variable*					newResult();
@@ -40,11 +118,55 @@ namespace Nodable{
 		Wire*                       newWire();
 		Node*                       newFunction(const Function* _proto);
 
-	private:		
+	private:
+		/* Sort nodes topologically and store the result into schedule */
+		void                        updateSchedule();
+
+		/* Remove from schedule the nodes neither the result nor a watched Member depend on (cf. setDemandDriven()) */
+		void                        keepDemandedNodes();
+
+		/* Evaluate the dirty nodes, return the evaluated node count */
+		size_t                      evaluateSequentially();
+		size_t                      evaluateInParallel();
+		size_t                      evaluateProgram();
+
+		void                        bindColumn(Variable* _variable, Type _type, const void* _values);
+		bool                        evaluateBatch(size_t _rowCount, Type _type, void* _results);
+
+		/* Rebuild the source expressions of the computed nodes flagged in outdatedSourceExpressions, and of their readers,
+		   inputs first: each one is built from its inputs' cached expressions (cf. Member::getSourceExpression()) */
+		void                        updateSourceExpressions();
+
+		/* Evaluate a single node and flag its readers as dirty if one of its outputs has changed.
+		   _outputs is a buffer to store the previous output values (reused between calls) */
+		void                        evaluate(Node* _node, std::vector<Variant>& _outputs);
+
+		/* Evaluate the scheduled node at _index, then the successors it releases (cf. evaluateInParallel()) */
+		void                        evaluateFrom(size_t _index, std::atomic<size_t>& _updatedNodesCount);
+
+		Arena                       arena;    /* owns the memory of all nodes/wires created by this container (declared first to be deleted last) */
 		Variable*                   resultNode = nullptr;
 		std::vector<Variable*> 		variables; /* Contain all Symbol Nodes created by this context */
+		std::unordered_map<std::string, Variable*> variablesByName; /* first variable created for each name (cf. findVariable()) */
 		std::vector<Node*>          nodes;   /* Contain all Objects created by this context */
 		const Language*             language;
+		std::vector<Node*>          schedule;                 /* nodes sorted topologically (cf. getSchedule()) */
+		bool                        scheduleOutdated = true;
+		bool                        scheduleHasCycle = false;
+		std::vector<std::vector<size_t>> successors;          /* for each scheduled node, indices of the nodes reading its outputs */
+		std::vector<size_t>         inputCounts;              /* for each scheduled node, count of its inputs within this container */
+		std::vector<std::atomic<size_t>> pendingInputCounts;  /* for each scheduled node, inputs not evaluated yet (parallel evaluation only) */
+		std::vector<bool>           outdatedSourceExpressions; /* for each scheduled node, its source expression must be rebuilt (cf. updateSourceExpressions()) */
+		EvaluationMode              evaluationMode = EvaluationMode::Sequential;
+		std::unique_ptr<Program>    program;
+		bool                        programOutdated = true;
+		size_t                      programRunCount = 0;      /* successful runs since the last compilation (cf. NativeCompilationRuns) */
+		std::future<NativeCompiler::Result> nativeCode;       /* native code of the current program, being built (cf. getProgram()) */
+		std::vector<Program::Column> columns;                 /* cf. bindColumn() */
+		bool                        demandDriven = false;
+		size_t                      transactionDepth = 0;
+		std::unordered_set<Node*>   pendingDirtyNodes;        /* nodes to flag as dirty on commit (cf. setDirty()) */
+		std::vector<Member*>        watchedMembers;           /* cf. watch() */
 	public:
 		static ImVec2               LastResultNodePosition;
 
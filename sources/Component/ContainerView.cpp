@@ -93,7 +93,7 @@ bool ContainerView::draw()
 				auto member   = draggedConnector->member;
 				auto node     = member->getOwner()->as<Node>();
 				auto view     = node->getComponent<NodeView>();
-				auto position = view->getConnectorPosition(member->getName(), draggedConnector->way);
+				auto position = view->getConnectorPosition(member, draggedConnector->way);
 
 				lineScreenPosStart = position + ImGui::GetWindowPos();
 			}
@@ -105,7 +105,7 @@ bool ContainerView::draw()
 				auto member     = hoveredConnector->member;
 				auto node       = member->getOwner()->as<Node>();
 				auto view       = node->getComponent<NodeView>();
-				auto position   = view->getConnectorPosition(member->getName(), hoveredConnector->way);
+				auto position   = view->getConnectorPosition(member, hoveredConnector->way);
 
 				lineScreenPosEnd = position + ImGui::GetWindowPos();
 			}
@@ -32,6 +32,20 @@ bool DataAccess::update()
         case Type::Boolean:
     		writer.Bool((bool)*_value);
     		break;
+
+        case Type::Int64:
+    		writer.Int64((int64_t)*_value);
+    		break;
+
+        case Type::Float32:
+    		writer.Double((double)(float)*_value);
+    		break;
+
+        case Type::Vec2:
+        case Type::Vec3:
+        case Type::Vec4:
+    		writer.String( ((std::string)*_value).c_str()); // ex: "vec3(1, 2, 3)"
+    		break;
     	default:
     		writer.Null();
     		break;
@@ -50,11 +64,9 @@ bool DataAccess::update()
     	writer.Key("members");
     	writer.StartObject();
     	{
-		    for(auto& each : owner->getMembers())
+		    for(auto each : owner->getMembers())
 		    {
-		    	auto value = each.second;
-
-		    	writeMember(value);
+		    	writeMember(each);
 		    }
 		}
 	    writer.EndObject();
@@ -65,15 +77,14 @@ bool DataAccess::update()
     	writer.Key("components");
     	writer.StartObject();
     	{
-		    for(auto& eachComponent : owner->getComponents())
+		    for(auto eachComponent : owner->getComponents())
 		    {
-		    	writer.Key   (eachComponent.first.c_str());
+		    	writer.Key   (eachComponent->getClass()->getName());
 		    	writer.StartObject();
 
-		    	for(auto& each : eachComponent.second->getMembers())
+		    	for(auto each : eachComponent->getMembers())
 			    {
-			    	auto value = each.second;
-			    	writeMember(value);
+			    	writeMember(each);
 			    }
 
 			    writer.EndObject();
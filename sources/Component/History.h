@@ -17,7 +17,6 @@
 #include "WireView.h"
 #include "Member.h"
 #include "Log.h"
-#include "NodeTraversal.h"
 
 namespace Nodable
 {
@@ -153,6 +152,7 @@ namespace Nodable
 			target->setInputMember(source);
 			auto targetNode = target->getOwner()->as<Node>();
 			auto sourceNode = source->getOwner()->as<Node>();
+			Container::Transaction transaction(targetNode->getParentContainer());
 
 			// Link wire to members
 			auto sourceContainer = sourceNode->getParentContainer();
@@ -169,7 +169,7 @@ namespace Nodable
 			targetNode->addWire(wire);
 			sourceNode->addWire(wire);
 
-			NodeTraversal::SetDirty(targetNode);
+			targetNode->flagAsDirty();
 		}
 
 		void redo() {
@@ -181,9 +181,10 @@ namespace Nodable
 
             auto targetNode = target->getOwner()->as<Node>();
             auto sourceNode = source->getOwner()->as<Node>();
+            Container::Transaction transaction(targetNode->getParentContainer());
 
             target->setInputMember(nullptr);
-            NodeTraversal::SetDirty(targetNode);
+            targetNode->flagAsDirty();
 
 			// Link Members
 			wire->setSource(nullptr);
@@ -193,7 +194,7 @@ namespace Nodable
             targetNode->removeWire(wire);
             sourceNode->removeWire(wire);
 
-			delete wire;
+			Arena::Delete(wire);
 		}
 
 		Wire* getWire() { return wire; }
@@ -8,7 +8,7 @@
 #include <algorithm>              // for std::max
 #include "Application.h"
 #include "ComputeBase.h"
-#include "NodeTraversal.h"
+#include "ComputeFunction.h"
 
 using namespace Nodable;
 
@@ -58,11 +58,13 @@ ImVec2 NodeView::getRoundedPosition()const
 	return roundedPosition;
 }
 
-ImVec2 NodeView::getConnectorPosition(const std::string& _name, Way _way)const
+ImVec2 NodeView::getConnectorPosition(const Member* _member, Way _way)const
 {
 	auto pos = position;
 
-	auto it = connectorOffsetPositionsY.find(_name);
+	auto it = std::find_if(connectorOffsetPositionsY.begin(), connectorOffsetPositionsY.end(), [_member](const auto& _each) {
+		return _each.first == _member;
+	});
 	if (it != connectorOffsetPositionsY.end())
 		pos.y += (*it).second;
 
@@ -286,19 +288,17 @@ bool NodeView::draw()
 	// Draw visible members
 	{
 		// Draw input only first
-		for(auto& m : node->getMembers())
+		for(auto member : node->getMembers())
 		{		
-			auto member = m.second;
 			if (member->getVisibility() == Visibility::Always && member->getConnectorWay() == Way_In)
 			{
-				drawMember(m.second);
+				drawMember(member);
 			}
 		}
 
 		// Then draw the rest
-		for (auto& m : node->getMembers())
+		for (auto member : node->getMembers())
 		{
-			auto member = m.second;
 			if (member->getVisibility() == Visibility::Always && member->getConnectorWay() != Way_In)
 			{
 				drawMember(member);
@@ -310,10 +310,8 @@ bool NodeView::draw()
 	if (!collapsed)
 	{	
 		// Draw visible members
-		for(auto& m : node->getMembers())
+		for(auto member : node->getMembers())
 		{		
-			auto member = m.second;
-
 			if( member->getVisibility() == Visibility::OnlyWhenUncollapsed ||
 				member->getVisibility() == Visibility::Hidden)
 			{
@@ -325,13 +323,8 @@ bool NodeView::draw()
 		ImGui::NewLine();
 		ImGui::Text("Components :");
 
-		for (auto& pair : node->getComponents()) {
-
-			auto component	= pair.second;
-			auto name		= pair.first;
-			auto className	= component->getClass()->getName();
-
-			ImGui::Text("- %s (%s)", name.c_str(), className);
+		for (auto component : node->getComponents()) {
+			ImGui::Text("- %s", component->getClass()->getName());
 		}
 
 		// Draw parentContainer's name
@@ -350,6 +343,11 @@ bool NodeView::draw()
 			if ( ImGui::Button("update()"))
 				node->update();
 		}
+
+		// Draw memo state (pure functions only)
+		auto compute = node->getComponent<ComputeFunction>();
+		if (compute && compute->isMemoEnabled())
+			ImGui::Text("Memo : %zu hits, %zu misses", compute->getMemoHits(), compute->getMemoMisses());
 	}
 
 	ImGui::PopItemWidth();
@@ -447,28 +445,39 @@ void NodeView::ArrangeRecursively(NodeView* _view)
 	}
 }
 
+/* Draw an input for a Vec2, Vec3 or Vec4 Member, return true if edited */
+template<size_t N>
+static bool DrawVecInput(Node* _node, Member* _member, ImGuiInputTextFlags _flags)
+{
+	auto value = (Vec<N>)*_member;
+
+	if (ImGui::InputScalarN("##value", ImGuiDataType_Float, value.values, N, nullptr, nullptr, "%g", _flags) && !_member->hasInputConnected())
+	{
+		_node->set(_member->getName().c_str(), value); // notifies the node (cf. Node::onMemberValueChanged)
+		return true;
+	}
+	return false;
+}
+
 bool NodeView::drawMember(Member* _member) {
 
 	bool edited = false;
 	auto node   = getOwner();
 	auto memberTopPositionOffsetY = ImGui::GetCursorPos().y - getRoundedPosition().y;
 
-	std::string label("##");
-	label.append(_member->getName());
-
     auto inputFlags = ImGuiInputTextFlags_None;
 
-	/* Draw the member */
+	/* Draw the member (its pointer is used as ImGui id to avoid building a label string) */
+	ImGui::PushID(_member);
 	switch (_member->getType())
 	{
 	case Type::Double:
 		{
 			auto f = (double)*_member;
 
-			if (ImGui::InputDouble(label.c_str(), &f, 0.0F, 0.0F, "%g", inputFlags ) && !_member->hasInputConnected())
+			if (ImGui::InputDouble("##value", &f, 0.0F, 0.0F, "%g", inputFlags ) && !_member->hasInputConnected())
 			{
-				_member->set(f);
-				NodeTraversal::SetDirty(node);
+				node->set(_member->getName().c_str(), f); // notifies the node (cf. Node::onMemberValueChanged)
 				edited |= true;
 			}
 			break;
@@ -478,33 +487,57 @@ bool NodeView::drawMember(Member* _member) {
 			char str[255];
 			snprintf(str, 255, "%s", ((std::string)*_member).c_str() );
 
-			if ( ImGui::InputText(label.c_str(), str, 255, inputFlags) && !_member->hasInputConnected() )
+			if ( ImGui::InputText("##value", str, 255, inputFlags) && !_member->hasInputConnected() )
 			{
-				_member->set(str);
-				NodeTraversal::SetDirty(node);
+				node->set(_member->getName().c_str(), str); // notifies the node (cf. Node::onMemberValueChanged)
 				edited |= true;
 			}
 			break;
 		}
 	case Type::Boolean:
 	{			
-		std::string checkBoxLabel = _member->getName();
-
 		auto b = (bool)*_member;
 
-		if (ImGui::Checkbox( checkBoxLabel.c_str(), &b ) && !_member->hasInputConnected() ) {
-			_member->set(b);
-			NodeTraversal::SetDirty(node);
+		if (ImGui::Checkbox( _member->getName().c_str(), &b ) && !_member->hasInputConnected() ) {
+			node->set(_member->getName().c_str(), b); // notifies the node (cf. Node::onMemberValueChanged)
 			edited |= true;
 		}
 		break;
 	}
+	case Type::Int64:
+		{
+			auto i = (int64_t)*_member;
+
+			if (ImGui::InputScalar("##value", ImGuiDataType_S64, &i, nullptr, nullptr, nullptr, inputFlags) && !_member->hasInputConnected())
+			{
+				node->set(_member->getName().c_str(), i); // notifies the node (cf. Node::onMemberValueChanged)
+				edited |= true;
+			}
+			break;
+		}
+	case Type::Float32:
+		{
+			auto f = (float)*_member;
+
+			if (ImGui::InputFloat("##value", &f, 0.0F, 0.0F, "%g", inputFlags) && !_member->hasInputConnected())
+			{
+				Member value(nullptr); // a float passed to set() would be stored as a double
+				value.setFloat32(f);
+				node->set(_member->getName().c_str(), &value); // notifies the node (cf. Node::onMemberValueChanged)
+				edited |= true;
+			}
+			break;
+		}
+	case Type::Vec2: edited |= DrawVecInput<2>(node, _member, inputFlags); break;
+	case Type::Vec3: edited |= DrawVecInput<3>(node, _member, inputFlags); break;
+	case Type::Vec4: edited |= DrawVecInput<4>(node, _member, inputFlags); break;
 	default:
 		{
 			ImGui::Text( "%s", _member->getName().c_str());
 			break;
 		}
 	}
+	ImGui::PopID();
 
 
 	/* If value is hovered, we draw a tooltip that print the source expression of the value*/
@@ -516,22 +549,21 @@ bool NodeView::drawMember(Member* _member) {
 	}
 
 	auto memberBottomPositionOffsetY = ImGui::GetCursorPos().y - getRoundedPosition().y;
-	connectorOffsetPositionsY[_member->getName()] = (memberTopPositionOffsetY + memberBottomPositionOffsetY) / 2.0f; // store y axis middle
+	connectorOffsetPositionsY.emplace_back(_member, (memberTopPositionOffsetY + memberBottomPositionOffsetY) / 2.0f); // store y axis middle
 
 	/*
 		Draw the wire connectors (In or Out only)
 	*/
 
 	ImDrawList* draw_list = ImGui::GetWindowDrawList();
-	auto memberName       = _member->getName();
 
 	if (_member->allowsConnection(Way_In)) {
-		ImVec2      connectorPos = getConnectorPosition( memberName, Way_In);
+		ImVec2      connectorPos = getConnectorPosition( _member, Way_In);
 		drawConnector(connectorPos, _member->input(), draw_list);
 	}
 		
 	if (_member->allowsConnection(Way_Out)) {
-		ImVec2      connectorPos = getConnectorPosition( memberName, Way_Out);
+		ImVec2      connectorPos = getConnectorPosition( _member, Way_Out);
 		drawConnector(connectorPos, _member->output(), draw_list);
 	}
 
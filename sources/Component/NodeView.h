@@ -45,7 +45,7 @@ namespace Nodable{
 		ImRect            getRect()const;
 
 		/* Get the connector position of the specified member (by name) for its Way way (In or Out ONLY !) */
-		ImVec2            getConnectorPosition(const std::string& /*_name*/, Way /*_connection*/)const;
+		ImVec2            getConnectorPosition(const Member* /*_member*/, Way /*_connection*/)const;
 
 		/* Set a new position (top-left corner) vector to this view */ 
 		void              setPosition         (ImVec2);
@@ -111,7 +111,7 @@ namespace Nodable{
 		bool            pinned              = false;                  // false: follow its outputs.
 		float           borderRadius        = 5.0f;
 		ImColor         borderColorSelected = ImColor(1.0f, 1.0f, 1.0f);
-		std::map<std::string, float> connectorOffsetPositionsY;
+		std::vector<std::pair<const Member*, float>> connectorOffsetPositionsY; // only a few members per node, a linear search is enough
 		static NodeView* s_selected; // pointer to the currently selected NodeView.
 		static NodeView* s_draggedNode;	 // pointer to the currently dragged NodeView.	
 		static const Connector* s_draggedConnector;
@@ -0,0 +1,43 @@
+#include "Arena.h"
+
+using namespace Nodable;
+
+void Arena::destroy(Node* _node)
+{
+	NODABLE_ASSERT(_node->getArena() == this);
+
+	// Each pool has its own object size, we need the exact type.
+	auto nodeClass = _node->getClass();
+
+	if (nodeClass == Variable::GetClass())
+		variables.destroy(static_cast<Variable*>(_node));
+	else if (nodeClass == Wire::GetClass())
+		wires.destroy(static_cast<Wire*>(_node));
+	else
+	{
+		NODABLE_ASSERT(nodeClass == Node::GetClass());
+		nodes.destroy(_node);
+	}
+}
+
+void Arena::reset()
+{
+	if (nodes.size() == 0)      nodes.reset();
+	if (variables.size() == 0)  variables.reset();
+	if (wires.size() == 0)      wires.reset();
+	if (members.size() == 0)    members.reset();
+	if (connectors.size() == 0) connectors.reset();
+}
+
+size_t Arena::size()const
+{
+	return nodes.size() + variables.size() + wires.size() + members.size() + connectors.size();
+}
+
+void Arena::Delete(Node* _node)
+{
+	if (auto arena = _node->getArena())
+		arena->destroy(_node);
+	else
+		delete _node;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+// Nodable
+#include "Nodable.h"    // forward declarations
+#include "Pool.h"
+#include "Member.h"
+#include "Connector.h"
+#include "Node.h"
+#include "Variable.h"
+#include "Wire.h"
+
+namespace Nodable{
+
+	/*
+		The role of this class is to own the memory of a graph (cf. Container).
+
+		Nodes, Variables, Wires, Members and Connectors are allocated in typed Pools, so objects of the same kind
+		are contiguous in memory and clearing a graph does not release/allocate memory again.
+		An Object created by an Arena knows it (cf. Object::getArena()) and gives it to the Objects it creates.
+		This class is not thread safe, objects must be created/destroyed from a single thread.
+	*/
+	class Arena
+	{
+	public:
+		Arena() = default;
+		~Arena() = default;
+
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+		/* Create a Node, Variable or Wire owned by this Arena (the Arena is passed as last constructor argument) */
+		template<typename T, typename... Args>
+		T* create(Args&&... _args)
+		{
+			return pool<T>().create(std::forward<Args>(_args)..., this);
+		}
+
+		Member*    createMember(Object* _owner) { return members.create(_owner); }
+		Connector* createConnector(Member* _member, Way _way) { return connectors.create(_member, _way); }
+
+		/* Destroy a Node (or a Variable or a Wire) created by this Arena */
+		void       destroy(Node* _node);
+		void       destroy(Member* _member) { members.destroy(_member); }
+		void       destroy(Connector* _connector) { connectors.destroy(_connector); }
+
+		/* Make the memory of each empty pool available again in address order (pools still in use are left as is) */
+		void       reset();
+
+		/* Count of objects still alive */
+		size_t     size()const;
+
+		/* Destroy _node with the Arena that created it, or using delete if it has been created with new */
+		static void Delete(Node* _node);
+
+	private:
+		template<typename T> Pool<T>& pool();
+
+		Pool<Node>      nodes;
+		Pool<Variable>  variables;
+		Pool<Wire>      wires;
+		Pool<Member>    members;
+		Pool<Connector> connectors;
+	};
+
+	template<> inline Pool<Node>&     Arena::pool<Node>()     { return nodes; }
+	template<> inline Pool<Variable>& Arena::pool<Variable>() { return variables; }
+	template<> inline Pool<Wire>&     Arena::pool<Wire>()     { return wires; }
+}
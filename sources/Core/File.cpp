@@ -39,6 +39,11 @@ Nodable::File::File( std::filesystem::path _path, const char* _content):
 	auto containerView = new ContainerView();
 	container->addComponent(containerView);
 
+	/* Creates the parser, unchanged nodes are kept, with their position and value, when the text changes */
+	parser = std::make_unique<Parser>(language, container);
+	parser->setReconciliationEnabled(true);
+	parser->setCache(&parseCache);
+
 	/* Add inputs in contextual menu */
 	auto api = language->getAllFunctions();
 
@@ -111,15 +116,21 @@ bool File::evaluateExpression(std::string& _expression)
 
 	auto container = getInnerContainer();
 
-	/* Create a Parser node. The Parser will cut expression string into tokens
+	/* The Parser will cut expression string into tokens
 	(ex: "2*3" will be tokenized as : number"->"2", "operator"->"*", "number"->"3")*/
-	Parser parser(language, container);
-	
-	if (parser.eval(_expression))
+	parser->setOptimizationEnabled(optimized);
+
+	bool firstBuild = container->getResultVariable() == nullptr;
+	bool success    = parser->eval(_expression);
+	statementCount  = parser->getStatementCount();
+	outdated        = !success;
+
+	if (success)
 	{
 		auto result = container->getResultVariable();
 		auto view   = result->getComponent<NodeView>();
-		NodeView::ArrangeRecursively(view);
+		if (firstBuild)
+			NodeView::ArrangeRecursively(view);
 		LOG_MESSAGE(0u, "Expression evaluated: %s\n", _expression.c_str());
 		return true;
 	}
@@ -135,6 +146,11 @@ UpdateResult File::update() {
 		}
 	}
 
+	// the graph of the last valid text is kept (positions, values) but neither evaluated nor written back
+	// until the text can be parsed again (ex: while typing "a * 2 +")
+	if (outdated)
+		return UpdateResult::SuccessWithoutChanges;
+
 	auto containerUpdateResult = getInnerContainer()->update();
 	auto view = getComponent<FileView>();
 
@@ -147,6 +163,10 @@ UpdateResult File::update() {
 		return UpdateResult::SuccessWithoutChanges;
 	}
 
+	// only the last statement of a program is connected to the result, the text can't be rebuilt from the graph.
+	if (statementCount > 1)
+		return UpdateResult::SuccessWithChanges;
+
 	auto member		= result->getMember();
 	auto expression = member->getSourceExpression();
 	
@@ -160,11 +180,15 @@ bool File::evaluateSelectedExpression()
 {
 	bool success;
 
-	getInnerContainer()->clear();
-
+	// the graph is not cleared, the Parser reconciles it with the new expression (cf. Parser::setReconciliationEnabled())
 	auto view = getComponent<FileView>();
 
 	auto expression = view->getSelectedText();
+
+	// nothing selected, nothing to show (the graph would otherwise be written back at the cursor, cf. update())
+	if (expression.empty())
+		getInnerContainer()->clear();
+
 	success = evaluateExpression(expression);
 
 	return success;
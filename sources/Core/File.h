@@ -4,6 +4,7 @@
 #include "Node.h"
 #include "Container.h"
 #include "History.h"
+#include "Parser.h"
 #include <mirror.h>
 
 #include <SDL.h>
@@ -12,6 +13,7 @@
 #include <string>
 #include <algorithm>
 #include <filesystem>
+#include <memory>
 
 #include "ImGuiColorTextEdit/TextEditor.h" // for coordinates
 
@@ -30,6 +32,13 @@ namespace Nodable
 		bool                             evaluateExpression(std::string&);
 		bool                             evaluateSelectedExpression();
 
+		/* Parser optimizations (cf. Parser::setOptimizationEnabled()), disabled to keep the graph close to the text */
+		void                             setOptimized(bool _optimized) { optimized = _optimized; }
+		bool                             isOptimized()const { return optimized; }
+
+		/* Programs already parsed by evaluateExpression() (cf. Parser::Cache) */
+		const Parser::Cache&             getParseCache()const { return parseCache; }
+
 		static File*                     OpenFile(std::filesystem::path _filePath);
 
 		inline History* getHistory() {
@@ -38,6 +47,11 @@ namespace Nodable
 
 	private:
 		bool                      modified = false;
+		bool                      optimized = false;
+		bool                      outdated = false;   // the last evaluated expression can't be parsed, the graph is the previous one
+		size_t                    statementCount = 0; // of the last evaluated expression
+		Parser::Cache             parseCache;         // undo/redo and selection changes evaluate the same texts again
+		std::unique_ptr<Parser>   parser;             // built once, its Lexer tables are reused by each evaluation
 		std::filesystem::path     path;		
 		const Language*           language;
 		MIRROR_CLASS(File)();
@@ -4,14 +4,19 @@
 #include <cstdio>  // vfprintf
 #include <iostream>
 #include <algorithm>
+#include <mutex>
 
 using namespace Nodable;
 
 std::vector<Message> Log::Logs;
 short unsigned int Log::VerbosityLevel = Log::DefaultVerbosityLevel;
 
+static std::mutex LogsMutex; // nodes can be evaluated from worker threads (cf. TaskScheduler)
+
 const Message* Log::GetLastMessage()
 {
+    std::lock_guard<std::mutex> lock(LogsMutex);
+
     auto found = std::find_if( Logs.rbegin(), Logs.rend(), [](auto item)-> bool {
         return item.verbosity <= Log::VerbosityLevel;
     });
@@ -44,6 +49,8 @@ void Log::Push(LogType _type, short unsigned int _verbosityLevel, const char* _f
         vsnprintf(buffer, sizeof(buffer), _format, arglist); // store into buffer
         va_end( arglist );
 
+        std::lock_guard<std::mutex> lock(LogsMutex);
+
         if( _type == LogType::Error )
             std::cout << RED "ERR " RESET << buffer;
         else if( _type == LogType::Warning )
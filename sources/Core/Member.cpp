@@ -1,6 +1,7 @@
 #include "Member.h"
 #include "Log.h"		 // for LOG_DEBUG(...)
 #include "Object.h"
+#include "Arena.h"
 #include "Variable.h"
 #include "Language.h"
 
@@ -12,8 +13,7 @@ Member::Member(Object* _owner):owner(_owner)
 
 Member::~Member()
 {
-    delete in;
-    delete out;
+    deleteConnectors();
 }
 
 Type Member::getType()const
@@ -40,25 +40,43 @@ bool Member::equals(const Member *_other)const {
 void Member::setConnectorWay(Way _flags)
 {
 	// Delete existing (we could reuse...)
-	if (in != nullptr)
-		delete in;
-
-	if (out != nullptr)
-		delete out;
+	deleteConnectors();
 
 	// Create an input if needed
 	if (_flags & Way_In)
-		in = new Connector(this, Way_In);
+		in = newConnector(Way_In);
 	else
 		in = nullptr;
 
 	// Create an output if needed
 	if (_flags & Way_Out)
-		out = new Connector(this, Way_Out);
+		out = newConnector(Way_Out);
 	else
 		out = nullptr;
 }
 
+Connector* Member::newConnector(Way _way)
+{
+	auto arena = owner != nullptr ? owner->getArena() : nullptr;
+	return arena != nullptr ? arena->createConnector(this, _way) : new Connector(this, _way);
+}
+
+void Member::deleteConnectors()
+{
+	auto arena = owner != nullptr ? owner->getArena() : nullptr;
+
+	for (auto connector : {in, out})
+	{
+		if (connector == nullptr)
+			continue;
+
+		if (arena != nullptr)
+			arena->destroy(connector);
+		else
+			delete connector;
+	}
+}
+
 void Nodable::Member::setSourceExpression(const char* _val)
 {
 	sourceExpression = _val;
@@ -189,18 +207,17 @@ std::string Member::getSourceExpression()const
 
 void Member::set(const Member* _v)
 {
-	data.set(&_v->data);
+	data = _v->data;
 }
 
 void Member::set(const Member& _v)
 {
-	data.set(&_v.data);
+	data = _v.data;
 }
 
 void Member::set(double _value)
 {
-	data.setType(Type::Double);
-	data.set(_value);
+	data.setDouble(_value);
 }
 
 void Member::set(int _value)
@@ -210,17 +227,35 @@ void Member::set(int _value)
 
 void Member::set(const std::string& _value)
 {
-	this->set(_value.c_str());
+	data.setString(_value.c_str(), _value.size());
 }
 
 void Member::set(const char* _value)
 {
-	data.setType(Type::String);
 	data.set(_value);
 }
 
+void Member::set(std::string_view _value)
+{
+	data.setString(_value.data(), _value.size());
+}
+
+void Member::set(const Variant& _value)
+{
+	data = _value;
+}
+
 void Member::set(bool _value)
 {
-	data.setType(Type::Boolean);
-	data.set(_value);
+	data.setBoolean(_value);
+}
+
+void Member::set(int64_t _value)
+{
+	data.setInt64(_value);
+}
+
+void Member::setFloat32(float _value)
+{
+	data.setFloat32(_value);
 }
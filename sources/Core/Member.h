@@ -7,6 +7,7 @@
 #include "Visibility.h"
 
 #include <string>
+#include <string_view>
 
 namespace Nodable
 {
@@ -111,11 +112,41 @@ namespace Nodable
          */
 		void set(const char* _value);
 
+        /**
+         * Set value given a string view (the chars are copied).
+         */
+		void set(std::string_view _value);
+
+        /**
+         * Set value (and type) given a Variant.
+         */
+		void set(const Variant& _value);
+
         /**
          * Set value given a boolean.
          */
 		void set(bool _value);
 
+        /**
+         * Set value given a 64 bits integer.
+         */
+		void set(int64_t _value);
+
+        /**
+         * Set value given a single precision floating point number.
+         * Not an overload of set(), a float passed to set() is still stored as a double.
+         */
+		void setFloat32(float _value);
+
+        /**
+         * Set value given a vector (Vec2, Vec3 or Vec4).
+         */
+		template<size_t N>
+		void set(const Vec<N>& _value)
+		{
+		    data.setVec(_value);
+		}
+
 		/**
 		 * Set a Type.
 		 * Type can be changed at any time but data will be lost (cf. Variant::setType).
@@ -156,7 +187,8 @@ namespace Nodable
 
         /**
          * Get the source expression string for this Member.
-         * Nothing will be computed, the string will be stored for later use.
+         * Nothing will be computed: the expression of a computed result is rebuilt by its Container
+         * once evaluated or rewired (cf. Container::updateSourceExpressions()).
          * TODO: remove this method.
          */
 		[[nodiscard]] std::string getSourceExpression()const;
@@ -186,6 +218,12 @@ namespace Nodable
          */
         [[nodiscard]] Way getConnectorWay()const;
 
+        /**
+         * Get the underlying data (ex: to compare values using Variant::operator==)
+         * @return a const reference to the Variant.
+         */
+        [[nodiscard]] const Variant& getData()const { return data; }
+
         /**
          * Get the input Connector
          * @return a pointer to the input Connector
@@ -234,7 +272,45 @@ namespace Nodable
 		    return (std::string)data;
 		}
 
+        /**
+         * Cast the underlying data to a 64 bits integer.
+         * @return
+         */
+		inline explicit operator int64_t()const
+		{
+		    return (int64_t)data;
+		}
+
+        /**
+         * Cast the underlying data to a single precision floating point number.
+         * @return
+         */
+		inline explicit operator float()const
+		{
+		    return (float)data;
+		}
+
+        /**
+         * Cast the underlying data to a vector (cf. Variant::operator Vec<N>()).
+         * @return
+         */
+		template<size_t N>
+		inline explicit operator Vec<N>()const
+		{
+		    return (Vec<N>)data;
+		}
+
 	private:
+        /**
+         * Create a Connector with the owner's Arena (if any).
+         */
+        Connector* newConnector(Way _way);
+
+        /**
+         * Delete input and output connectors (they are not reset to nullptr).
+         */
+        void deleteConnectors();
+
         /**
          * The Object that owns this. Owner is responsible to create/delete this.
          */
@@ -39,12 +39,18 @@ namespace Nodable{
 	class Member;
 	class Variant;
 	class Object;
+	class Arena;
+	class Connector;
 	
 	// Components :
 	class Component;
 	class History;
+	class DataAccess;
+	class ComputeBase;
+	class ComputeUnaryOperation;
 
 	// View Components
+	class View;
 	class NodeView;
 	class ContainerView;
 	class ApplicationView;
@@ -52,6 +58,7 @@ namespace Nodable{
 	class FileView;
 
 	// Binary Operation Components
+	class ComputeFunction;
 	class ComputeBinaryOperation;
 	class Add;
 	class Subtract;
@@ -63,6 +70,10 @@ namespace Nodable{
 	class Node;
 	class Application;	
 	class Parser;
+	class Lexer;
+	class Language;
+	class Compiler;
+	class Program;
 	class Variable;
 	class Container;
 
@@ -70,8 +81,8 @@ namespace Nodable{
 	class Log;	
 	class File;
 
-	typedef std::map<std::string, Component*>  Components;
-	typedef std::map<std::string, Member*>     Members;
+	typedef std::vector<Component*>            Components; /* in insertion order (cf. Node::getComponent<T>() for a fast access) */
+	typedef std::vector<Member*>               Members;    /* index is the Member's slot (cf. Object::getSlot()) */
 	typedef std::vector<Wire*>                 Wires;
 }
 
@@ -1,8 +1,11 @@
 #include "Object.h"
+#include "Arena.h"
+#include <algorithm>    // for std::find
 
 using namespace Nodable;
 
-Object::Object()
+Object::Object(Arena* _arena):
+	arena(_arena)
 {
 	add("__class__", Visibility::OnlyWhenUncollapsed);
 	add("name",      Visibility::OnlyWhenUncollapsed);
@@ -11,7 +14,12 @@ Object::Object()
 Object::~Object()
 {
 	for(auto each : members)
-		delete each.second;
+	{
+		if (arena != nullptr)
+			arena->destroy(each);
+		else
+			delete each;
+	}
 }
 
 
@@ -22,48 +30,53 @@ const Members&   Object::getMembers      ()const
 
 bool Object::has(Member* _value)
 {
-	auto foundWithName = members.find(_value->getName());
-	if( foundWithName != members.end())
-		return (*foundWithName).second == _value;
-	return false;
+	return std::find(members.begin(), members.end(), _value) != members.end();
+}
+
+size_t Object::getSlot (const char* _name)const
+{
+	// Objects have only a few members, a linear search is faster than a map lookup (and needs no std::string).
+	for (size_t slot = 0; slot < members.size(); slot++)
+	{
+		if (members[slot]->getName() == _name)
+			return slot;
+	}
+	return InvalidSlot;
 }
 
 Member* Object::get (const char* _name)const
 {
-	auto foundWithName = members.find(std::string(_name));
-	if (foundWithName != members.end())
-		return (*foundWithName).second;
+	auto slot = getSlot(_name);
+	if (slot != InvalidSlot)
+		return members[slot];
 	return nullptr;
 }
 
 Member* Object::get (const std::string& _name)const
 {
-	return members.at(_name.c_str());
+	return get(_name.c_str());
 }
 
 Member* Object::getFirstWithConn(Way _connection)const
 {
-	Member* found = nullptr;
-
-	auto m = this->members.begin();
-	while (m != this->members.end() && found == nullptr)
+	for (auto each : members)
 	{
-		if (m->second->getConnectorWay() & _connection)
-			found = m->second;
-		m++;
+		if (each->getConnectorWay() & _connection)
+			return each;
 	}
-
-	return found;
+	return nullptr;
 }
 
 Member* Object::add (const char* _name, Visibility _visibility, Type _type, Way _flags )
 {
-	auto v = new Member(this);
+	NODABLE_ASSERT(getSlot(_name) == InvalidSlot); // member names must be unique
+
+	auto v = arena != nullptr ? arena->createMember(this) : new Member(this);
 	v->setName		(_name);
 	v->setVisibility(_visibility);
 	v->setType		(_type);
 	v->setConnectorWay(_flags);
-	members[std::string(_name)] = v;
+	members.push_back(v);
 
 	return v;
 }
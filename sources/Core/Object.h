@@ -7,14 +7,20 @@ namespace Nodable
 {
 	/*
 		Object is the base class for all classes that needs to have members (std::string key => Nodable::Value value)
+
+		Members are stored in a table following their creation order. The index of a member in this table (its slot)
+		never changes, so it can be resolved once by name (cf. getSlot()) and then used to access it directly (cf. getAt()).
 	*/
 
 	class Object
 	{
 	public:
-		Object();
+		explicit Object(Arena* _arena = nullptr);
 		virtual ~Object();
 
+		/* Get the Arena that created this Object (and creates its members), nullptr if created with new */
+		Arena*              getArena    ()const { return arena; }
+
 		/* Adds a new member identified by its _name. */
 		Member*             add         (const char*, Visibility = Visibility::Default, Type = Type::Any, Way = Way_Default);
 
@@ -30,6 +36,12 @@ namespace Nodable
 		/* Returns a pointer to the member value identified by its name.
 		Or nullptr if this member doesn't exists. */
 		Member*              get         (const char* _name)const;
+
+		/* Returns the slot of the member identified by its name, or InvalidSlot if this member doesn't exists. */
+		size_t               getSlot     (const char* _name)const;
+
+		/* Returns a pointer to the member at a given slot (no check, cf. getSlot()) */
+		Member*              getAt       (size_t _slot)const { return members[_slot]; }
 		
 		/* Return all members of this object */
 		const Members&      getMembers        ()const;
@@ -45,7 +57,7 @@ namespace Nodable
 		template<typename T>
 		void set(const char* _name, T _value)
 		{
-			members[std::string(_name)]->set(_value);
+			get(_name)->set(_value);
 			this->onMemberValueChanged(_name);
 		}
 
@@ -59,8 +71,11 @@ namespace Nodable
 	private:
 		Members             members;
 		bool                deleted = false;
+		Arena*              arena;
 
 	public:
+		static constexpr size_t InvalidSlot = size_t(-1);
+
 		MIRROR_CLASS(Object)();
 	};	
 }
\ No newline at end of file
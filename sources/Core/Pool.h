@@ -0,0 +1,93 @@
+#pragma once
+
+// std
+#include <vector>
+#include <memory>
+#include <utility>
+
+// Nodable
+#include "Nodable.h"    // for NODABLE_ASSERT
+
+namespace Nodable{
+
+	/*
+		The role of this class is to allocate objects of a single type T.
+
+		Objects are constructed in chunks of ChunkSize contiguous slots. A destroyed object's slot is reused
+		by the next create() call, and the memory is released all at once when the Pool is deleted.
+		This class is not thread safe.
+	*/
+	template<typename T, size_t ChunkSize = 64>
+	class Pool
+	{
+	public:
+		Pool() = default;
+		~Pool() { NODABLE_ASSERT(count == 0); } // objects must be destroyed before (memory is released anyway)
+
+		Pool(const Pool&) = delete;
+		Pool& operator=(const Pool&) = delete;
+
+		/* Construct a new T in a free slot */
+		template<typename... Args>
+		T* create(Args&&... _args)
+		{
+			if (freeList == nullptr)
+				grow();
+
+			Slot* slot = freeList;
+			freeList   = slot->next;
+			count++;
+			return new (slot->storage) T(std::forward<Args>(_args)...);
+		}
+
+		/* Destruct _object (must have been created by this pool) and free its slot */
+		void destroy(T* _object)
+		{
+			_object->~T();
+			auto slot  = reinterpret_cast<Slot*>(_object);
+			slot->next = freeList;
+			freeList   = slot;
+			count--;
+		}
+
+		/* Free all slots at once, in address order, so the next objects will be contiguous again.
+		   All objects must have been destroyed before. */
+		void reset()
+		{
+			NODABLE_ASSERT(count == 0);
+			freeList = nullptr;
+			for (auto chunk = chunks.rbegin(); chunk != chunks.rend(); chunk++)
+				link(chunk->get());
+		}
+
+		size_t size()const { return count; }
+		size_t capacity()const { return chunks.size() * ChunkSize; }
+
+	private:
+		union Slot
+		{
+			Slot* next;
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		void grow()
+		{
+			chunks.emplace_back(new Slot[ChunkSize]);
+			link(chunks.back().get());
+		}
+
+		/* Push all slots of a chunk on top of the free list (the first slot will be the first to be used) */
+		void link(Slot* _chunk)
+		{
+			for (size_t i = ChunkSize; i > 0; i--)
+			{
+				_chunk[i - 1].next = freeList;
+				freeList = &_chunk[i - 1];
+			}
+		}
+
+		std::vector<std::unique_ptr<Slot[]>> chunks;
+		Slot*                                freeList = nullptr;
+		size_t                               count    = 0;
+	};
+}
@@ -0,0 +1,275 @@
+#include "Program.h"
+#include "Member.h"
+
+#include <cmath>
+#include <algorithm>
+
+static_assert(sizeof(bool) == 1, "bool columns are read as boolean registers");
+
+using namespace Nodable;
+
+unsigned int Program::newRegister(Type _type)
+{
+	NODABLE_ASSERT(_type == Type::Double || _type == Type::Boolean);
+
+	if (_type == Type::Double)
+	{
+		numbers.push_back(0.0);
+		return (unsigned int)numbers.size() - 1;
+	}
+
+	booleans.push_back(0);
+	return (unsigned int)booleans.size() - 1;
+}
+
+void Program::push(OpCode _code, unsigned int _dst, unsigned int _a, unsigned int _b)
+{
+	instructions.push_back({_code, _dst, _a, _b});
+}
+
+void Program::bindInput(Member* _member, unsigned int _reg, Type _type)
+{
+	inputs.push_back({_member, _reg, _type});
+}
+
+void Program::bindOutput(Member* _member, unsigned int _reg, Type _type)
+{
+	outputs.push_back({_member, _reg, _type});
+}
+
+void Program::clear()
+{
+	instructions.clear();
+	numbers.clear();
+	booleans.clear();
+	inputs.clear();
+	outputs.clear();
+	nativeCode = nullptr;
+	nativeLibrary.reset();
+}
+
+void Program::setNativeCode(NativeCode _code, std::shared_ptr<void> _library)
+{
+	nativeCode    = _code;
+	nativeLibrary = std::move(_library);
+}
+
+bool Program::run()
+{
+	for (const auto& input : inputs)
+	{
+		if (!input.member->isType(input.type))
+			return false;
+	}
+
+	for (const auto& input : inputs)
+	{
+		if (input.type == Type::Double)
+			numbers[input.reg] = (double)*input.member;
+		else
+			booleans[input.reg] = (bool)*input.member;
+	}
+
+	execute();
+
+	for (const auto& output : outputs)
+	{
+		if (output.type == Type::Double)
+			output.member->set(numbers[output.reg]);
+		else
+			output.member->set(booleans[output.reg] != 0);
+	}
+
+	return true;
+}
+
+bool Program::runBatch(const std::vector<Column>& _columns, size_t _rowCount,
+                       const Member* _output, Type _type, void* _results)
+{
+	for (const auto& input : inputs)
+	{
+		if (!input.member->isType(input.type))
+			return false;
+	}
+
+	// find the register to store into _results (an output, or an input read as is)
+	const Binding* result = nullptr;
+	for (const auto* bindings : {&outputs, &inputs})
+	{
+		auto found = std::find_if(bindings->begin(), bindings->end(), [&](const Binding& _each) {
+			return _each.member == _output;
+		});
+		if (found != bindings->end())
+		{
+			result = &*found;
+			break;
+		}
+	}
+
+	if (result == nullptr || result->type != _type)
+		return false;
+
+	// each input reads a column or its Member
+	std::vector<const Column*> inputColumns(inputs.size(), nullptr);
+	for (size_t i = 0; i < inputs.size(); i++)
+	{
+		for (const auto& column : _columns)
+		{
+			if (column.member == inputs[i].member)
+			{
+				if (column.type != inputs[i].type)
+					return false;
+				inputColumns[i] = &column;
+			}
+		}
+	}
+
+	// a block of BatchSize rows per register
+	numberBlocks.resize(numbers.size() * BatchSize);
+	booleanBlocks.resize(booleans.size() * BatchSize);
+	numberRows.resize(numbers.size());
+	booleanRows.resize(booleans.size());
+
+	for (size_t reg = 0; reg < numbers.size(); reg++)
+		numberRows[reg] = numberBlocks.data() + reg * BatchSize;
+
+	for (size_t reg = 0; reg < booleans.size(); reg++)
+		booleanRows[reg] = booleanBlocks.data() + reg * BatchSize;
+
+	// inputs without column are the same for all rows, instructions never write input registers
+	for (size_t i = 0; i < inputs.size(); i++)
+	{
+		const auto& input = inputs[i];
+		if (inputColumns[i] != nullptr)
+			continue;
+
+		if (input.type == Type::Double)
+			std::fill_n(numberRows[input.reg], BatchSize, (double)*input.member);
+		else
+			std::fill_n(booleanRows[input.reg], BatchSize, (unsigned char)(bool)*input.member);
+	}
+
+	for (size_t first = 0; first < _rowCount; first += BatchSize)
+	{
+		const size_t count = std::min(BatchSize, _rowCount - first);
+
+		for (size_t i = 0; i < inputs.size(); i++)
+		{
+			if (auto column = inputColumns[i])
+			{
+				if (column->type == Type::Double)
+					std::copy_n((const double*)column->values + first, count, numberRows[inputs[i].reg]);
+				else
+					std::copy_n((const unsigned char*)column->values + first, count, booleanRows[inputs[i].reg]);
+			}
+		}
+
+		executeBatch(count);
+
+		if (_type == Type::Double)
+			std::copy_n(numberRows[result->reg], count, (double*)_results + first);
+		else
+			std::copy_n(booleanRows[result->reg], count, (unsigned char*)_results + first);
+	}
+
+	return true;
+}
+
+namespace
+{
+	/* Loops over a block of rows, kept trivial so the compiler can vectorize them */
+	template<typename D, typename A, typename F>
+	inline void UnaryKernel(D* _dst, const A* _a, size_t _count, F _function)
+	{
+		for (size_t row = 0; row < _count; row++)
+			_dst[row] = _function(_a[row]);
+	}
+
+	template<typename D, typename A, typename F>
+	inline void BinaryKernel(D* _dst, const A* _a, const A* _b, size_t _count, F _function)
+	{
+		for (size_t row = 0; row < _count; row++)
+			_dst[row] = _function(_a[row], _b[row]);
+	}
+}
+
+void Program::executeBatch(size_t _count)
+{
+	double**        n = numberRows.data();
+	unsigned char** b = booleanRows.data();
+	const size_t    c = _count;
+
+	for (const auto& i : instructions)
+	{
+		switch (i.code)
+		{
+		case OpCode::Copy:           UnaryKernel(n[i.dst], n[i.a], c, [](double a) { return a; });                        break;
+		case OpCode::Negate:         UnaryKernel(n[i.dst], n[i.a], c, [](double a) { return -a; });                       break;
+		case OpCode::SquareRoot:     UnaryKernel(n[i.dst], n[i.a], c, [](double a) { return std::sqrt(a); });             break;
+		case OpCode::Sine:           UnaryKernel(n[i.dst], n[i.a], c, [](double a) { return std::sin(a); });              break;
+		case OpCode::Cosine:         UnaryKernel(n[i.dst], n[i.a], c, [](double a) { return std::cos(a); });              break;
+		case OpCode::Add:            BinaryKernel(n[i.dst], n[i.a], n[i.b], c, [](double a, double b) { return a + b; });  break;
+		case OpCode::Subtract:       BinaryKernel(n[i.dst], n[i.a], n[i.b], c, [](double a, double b) { return a - b; });  break;
+		case OpCode::Multiply:       BinaryKernel(n[i.dst], n[i.a], n[i.b], c, [](double a, double b) { return a * b; });  break;
+		case OpCode::Divide:         BinaryKernel(n[i.dst], n[i.a], n[i.b], c, [](double a, double b) { return a / b; });  break;
+		case OpCode::Modulo:         BinaryKernel(n[i.dst], n[i.a], n[i.b], c, [](double a, double b) { return std::fmod(std::trunc(a), std::trunc(b)); }); break;
+		case OpCode::Power:          BinaryKernel(n[i.dst], n[i.a], n[i.b], c, [](double a, double b) { return std::pow(a, b); }); break;
+		case OpCode::Greater:        BinaryKernel(b[i.dst], n[i.a], n[i.b], c, [](double a, double b) -> unsigned char { return a >  b; }); break;
+		case OpCode::GreaterOrEqual: BinaryKernel(b[i.dst], n[i.a], n[i.b], c, [](double a, double b) -> unsigned char { return a >= b; }); break;
+		case OpCode::Less:           BinaryKernel(b[i.dst], n[i.a], n[i.b], c, [](double a, double b) -> unsigned char { return a <  b; }); break;
+		case OpCode::LessOrEqual:    BinaryKernel(b[i.dst], n[i.a], n[i.b], c, [](double a, double b) -> unsigned char { return a <= b; }); break;
+		case OpCode::Equal:          BinaryKernel(b[i.dst], n[i.a], n[i.b], c, [](double a, double b) -> unsigned char { return a == b; }); break;
+		case OpCode::ToBoolean:      UnaryKernel(b[i.dst], n[i.a], c, [](double a) -> unsigned char { return a != 0.0; });  break;
+		case OpCode::CopyBoolean:    UnaryKernel(b[i.dst], b[i.a], c, [](unsigned char a) -> unsigned char { return a; });  break;
+		case OpCode::Not:            UnaryKernel(b[i.dst], b[i.a], c, [](unsigned char a) -> unsigned char { return !a; }); break;
+		case OpCode::And:            BinaryKernel(b[i.dst], b[i.a], b[i.b], c, [](unsigned char a, unsigned char b) -> unsigned char { return a & b; });  break;
+		case OpCode::Or:             BinaryKernel(b[i.dst], b[i.a], b[i.b], c, [](unsigned char a, unsigned char b) -> unsigned char { return a | b; });  break;
+		case OpCode::Xor:            BinaryKernel(b[i.dst], b[i.a], b[i.b], c, [](unsigned char a, unsigned char b) -> unsigned char { return a != b; }); break;
+		case OpCode::Implies:        BinaryKernel(b[i.dst], b[i.a], b[i.b], c, [](unsigned char a, unsigned char b) -> unsigned char { return !a | b; }); break;
+		case OpCode::Equivalent:     BinaryKernel(b[i.dst], b[i.a], b[i.b], c, [](unsigned char a, unsigned char b) -> unsigned char { return a == b; }); break;
+		}
+	}
+}
+
+void Program::execute()
+{
+	if (nativeCode != nullptr)
+	{
+		nativeCode(numbers.data(), booleans.data());
+		return;
+	}
+
+	double*        n = numbers.data();
+	unsigned char* b = booleans.data();
+
+	for (const auto& i : instructions)
+	{
+		switch (i.code)
+		{
+		case OpCode::Copy:           n[i.dst] = n[i.a];                              break;
+		case OpCode::Negate:         n[i.dst] = -n[i.a];                             break;
+		case OpCode::SquareRoot:     n[i.dst] = std::sqrt(n[i.a]);                   break;
+		case OpCode::Sine:           n[i.dst] = std::sin(n[i.a]);                    break;
+		case OpCode::Cosine:         n[i.dst] = std::cos(n[i.a]);                    break;
+		case OpCode::Add:            n[i.dst] = n[i.a] + n[i.b];                     break;
+		case OpCode::Subtract:       n[i.dst] = n[i.a] - n[i.b];                     break;
+		case OpCode::Multiply:       n[i.dst] = n[i.a] * n[i.b];                     break;
+		case OpCode::Divide:         n[i.dst] = n[i.a] / n[i.b];                     break;
+		case OpCode::Modulo:         n[i.dst] = std::fmod(std::trunc(n[i.a]), std::trunc(n[i.b])); break;
+		case OpCode::Power:          n[i.dst] = std::pow(n[i.a], n[i.b]);            break;
+		case OpCode::Greater:        b[i.dst] = n[i.a] >  n[i.b];                    break;
+		case OpCode::GreaterOrEqual: b[i.dst] = n[i.a] >= n[i.b];                    break;
+		case OpCode::Less:           b[i.dst] = n[i.a] <  n[i.b];                    break;
+		case OpCode::LessOrEqual:    b[i.dst] = n[i.a] <= n[i.b];                    break;
+		case OpCode::Equal:          b[i.dst] = n[i.a] == n[i.b];                    break;
+		case OpCode::ToBoolean:      b[i.dst] = n[i.a] != 0.0;                       break;
+		case OpCode::CopyBoolean:    b[i.dst] = b[i.a];                              break;
+		case OpCode::Not:            b[i.dst] = !b[i.a];                             break;
+		case OpCode::And:            b[i.dst] = b[i.a] && b[i.b];                    break;
+		case OpCode::Or:             b[i.dst] = b[i.a] || b[i.b];                    break;
+		case OpCode::Xor:            b[i.dst] = b[i.a] != b[i.b];                    break;
+		case OpCode::Implies:        b[i.dst] = !b[i.a] || b[i.b];                   break;
+		case OpCode::Equivalent:     b[i.dst] = b[i.a] == b[i.b];                    break;
+		}
+	}
+}
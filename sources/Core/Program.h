@@ -0,0 +1,163 @@
+#pragma once
+
+// std
+#include <vector>
+#include <memory>
+
+// Nodable
+#include "Nodable.h"    // forward declarations
+#include "Type.h"
+
+namespace Nodable{
+
+	/*
+		Distinguish between all instructions a Program can execute.
+		Each instruction reads its operands (a, b) and writes its destination (dst) into typed registers,
+		the register bank (numbers or booleans) is implied by the OpCode.
+	*/
+	enum class OpCode: unsigned char
+	{
+		// number (a) -> number (dst)
+		Copy,
+		Negate,
+		SquareRoot,
+		Sine,
+		Cosine,
+
+		// number (a, b) -> number (dst)
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Modulo,         // remainder of the integer parts, NaN for a zero divisor (same as mod() in LanguageNodable)
+		Power,
+
+		// number (a, b) -> boolean (dst)
+		Greater,
+		GreaterOrEqual,
+		Less,
+		LessOrEqual,
+		Equal,
+
+		// number (a) -> boolean (dst)
+		ToBoolean,
+
+		// boolean (a) -> boolean (dst)
+		CopyBoolean,
+		Not,
+
+		// boolean (a, b) -> boolean (dst)
+		And,
+		Or,
+		Xor,
+		Implies,
+		Equivalent
+	};
+
+	struct Instruction
+	{
+		OpCode       code;
+		unsigned int dst;
+		unsigned int a;
+		unsigned int b;
+	};
+
+	/*
+		The role of this class is to evaluate a graph lowered as a linear list of Instructions (cf. Compiler).
+
+		Member values are loaded into registers before executing the instructions (inputs),
+		and registers are stored back into Members after (outputs).
+
+		The same instructions can also be executed over many rows at once (cf. runBatch()): some inputs are read from
+		columns of values, each register then holds a block of rows and each instruction is a loop over this block
+		(the compiler vectorizes these loops).
+
+		Instructions can be replaced by native code (cf. NativeCompiler), run() then calls it instead of interpreting them.
+	*/
+	class Program
+	{
+	public:
+		/* A Member linked to a register */
+		struct Binding
+		{
+			Member*      member;
+			unsigned int reg;
+			Type         type;
+		};
+
+		/* A column of values (one per row) for an input Member, values are double or bool depending on type */
+		struct Column
+		{
+			const Member* member;
+			Type          type;
+			const void*   values;
+		};
+
+		/* Instructions compiled to machine code, reads and writes the number and boolean registers */
+		typedef void (*NativeCode)(double* _numbers, unsigned char* _booleans);
+
+		/* Rows executed at once by runBatch(), each register is a block of BatchSize values */
+		static constexpr size_t     BatchSize = 256;
+
+		Program() = default;
+		~Program() = default;
+
+		/* Allocate a new register of a given type (Double or Boolean), return its index in its bank */
+		unsigned int                newRegister(Type _type);
+
+		/* Append an instruction */
+		void                        push(OpCode _code, unsigned int _dst, unsigned int _a, unsigned int _b = 0);
+
+		/* Load _member's value into the register _reg before each execution */
+		void                        bindInput(Member* _member, unsigned int _reg, Type _type);
+
+		/* Store the register _reg into _member after each execution */
+		void                        bindOutput(Member* _member, unsigned int _reg, Type _type);
+
+		/* Load inputs, execute instructions and store outputs.
+		   Return false (without executing anything) if an input Member type has changed since compilation. */
+		bool                        run();
+
+		/* Execute instructions only (registers must be set), using the native code if any */
+		void                        execute();
+
+		/* Execute _code instead of interpreting the instructions, _library keeps the code loaded (cf. NativeCompiler).
+		   The native code is removed by clear(). */
+		void                        setNativeCode(NativeCode _code, std::shared_ptr<void> _library);
+		bool                        hasNativeCode()const { return nativeCode != nullptr; }
+
+		/* Execute instructions for _rowCount rows. An input with a column reads its value for each row in it,
+		   other inputs are loaded from their Member once. The value of _output for each row is written to _results
+		   (double or bool depending on _type). Members are left unchanged.
+		   Return false (without executing anything) if a type does not match or _output is not a Member of the program. */
+		bool                        runBatch(const std::vector<Column>& _columns, size_t _rowCount,
+		                                     const Member* _output, Type _type, void* _results);
+
+		void                        clear();
+		size_t                      getInstructionCount()const { return instructions.size(); }
+		const std::vector<Instruction>& getInstructions()const { return instructions; }
+		const std::vector<Binding>& getInputs()const { return inputs; }
+		const std::vector<Binding>& getOutputs()const { return outputs; }
+		double&                     number(unsigned int _reg) { return numbers[_reg]; }
+		bool                        boolean(unsigned int _reg)const { return booleans[_reg] != 0; }
+		void                        setBoolean(unsigned int _reg, bool _value) { booleans[_reg] = _value; }
+
+	private:
+		/* Execute instructions for _count rows (cf. runBatch()) */
+		void                        executeBatch(size_t _count);
+
+		std::vector<Instruction>    instructions;
+		std::vector<double>         numbers;   /* number registers */
+		std::vector<unsigned char>  booleans;  /* boolean registers (not a std::vector<bool> to avoid bit packing) */
+		std::vector<Binding>        inputs;
+		std::vector<Binding>        outputs;
+		NativeCode                  nativeCode = nullptr;
+		std::shared_ptr<void>       nativeLibrary;
+
+		/* runBatch() registers, a block of rows per register pointing to the scratch memory or to a column */
+		std::vector<double*>        numberRows;
+		std::vector<unsigned char*> booleanRows;
+		std::vector<double>         numberBlocks;
+		std::vector<unsigned char>  booleanBlocks;
+	};
+}
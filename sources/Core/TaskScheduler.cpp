@@ -0,0 +1,152 @@
+#include "TaskScheduler.h"
+#include "Nodable.h"    // for NODABLE_ASSERT
+
+using namespace Nodable;
+
+thread_local TaskScheduler* TaskScheduler::s_currentScheduler = nullptr;
+thread_local size_t         TaskScheduler::s_currentWorker    = 0;
+
+TaskScheduler::TaskScheduler(size_t _workerCount)
+{
+    if (_workerCount == 0)
+        _workerCount = DefaultWorkerCount();
+
+    workers.reserve(_workerCount);
+    for (size_t i = 0; i < _workerCount; i++)
+        workers.push_back(std::make_unique<Worker>());
+
+    // Threads are started once every queue exists since they can steal from each other.
+    for (size_t i = 0; i < _workerCount; i++)
+        workers[i]->thread = std::thread(&TaskScheduler::run, this, i);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    wait();
+
+    stopping = true;
+    notify();
+
+    for (auto& worker : workers)
+        worker->thread.join();
+}
+
+size_t TaskScheduler::DefaultWorkerCount()
+{
+    auto hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+
+TaskScheduler& TaskScheduler::Shared()
+{
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+void TaskScheduler::spawn(Task _task)
+{
+    pendingCount++;
+
+    // A worker keeps its own tasks (the last spawned is likely to use hot data), others are distributed.
+    size_t queueIndex = s_currentScheduler == this ? s_currentWorker : nextQueue++ % workers.size();
+    {
+        auto& worker = *workers[queueIndex];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(_task));
+    }
+
+    queuedCount++;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        sleepCondition.notify_one();
+    }
+}
+
+void TaskScheduler::wait()
+{
+    NODABLE_ASSERT(s_currentScheduler != this); // a worker waiting for tasks could wait for itself.
+
+    Task task;
+    while (pendingCount > 0)
+    {
+        if (trySteal(workers.size() - 1, task))
+        {
+            execute(task);
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepCondition.wait(lock, [this] { return pendingCount == 0 || queuedCount > 0; });
+        }
+    }
+}
+
+void TaskScheduler::run(size_t _index)
+{
+    s_currentScheduler = this;
+    s_currentWorker    = _index;
+
+    Task task;
+    while (true)
+    {
+        if (tryPop(_index, task) || trySteal(_index, task))
+        {
+            execute(task);
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepCondition.wait(lock, [this] { return stopping || queuedCount > 0; });
+
+            if (stopping && queuedCount == 0)
+                return;
+        }
+    }
+}
+
+bool TaskScheduler::tryPop(size_t _index, Task& _task)
+{
+    auto& worker = *workers[_index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+
+    if (worker.tasks.empty())
+        return false;
+
+    _task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    queuedCount--;
+    return true;
+}
+
+bool TaskScheduler::trySteal(size_t _index, Task& _task)
+{
+    for (size_t i = 1; i <= workers.size(); i++)
+    {
+        auto& victim = *workers[(_index + i) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+
+        if (!victim.tasks.empty())
+        {
+            _task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queuedCount--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::execute(Task& _task)
+{
+    _task();
+    _task = nullptr;
+
+    if (--pendingCount == 0)
+        notify();
+}
+
+void TaskScheduler::notify()
+{
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    sleepCondition.notify_all();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Nodable{
+
+	/**
+		The role of this class is to run small tasks concurrently on a fixed pool of worker threads.
+
+		Each worker owns a task queue: it pushes and pops its own tasks at the back (most recent first,
+		good for cache locality) and steals the oldest tasks at the front of the other queues when its own is empty.
+		Tasks spawned from a non-worker thread are distributed among the worker queues.
+
+		note: wait() must be called from a non-worker thread, the calling thread helps to run tasks while waiting.
+	*/
+	class TaskScheduler
+	{
+	public:
+		using Task = std::function<void()>;
+
+		/** Create a scheduler with _workerCount threads (0 means DefaultWorkerCount()) */
+		explicit TaskScheduler(size_t _workerCount = 0);
+		~TaskScheduler();
+
+		TaskScheduler(const TaskScheduler&) = delete;
+		TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+		/** Push a new task, it will be run as soon as a worker is available */
+		void                        spawn(Task _task);
+
+		/** Block until all spawned tasks (including the ones spawned by tasks) are done */
+		void                        wait();
+
+		/** Get the worker thread count */
+		[[nodiscard]] size_t        getWorkerCount()const { return workers.size(); }
+
+		/** Get a worker count suitable for this machine (hardware threads minus the calling thread) */
+		static size_t               DefaultWorkerCount();
+
+		/** Get a scheduler shared by the whole application (created on first use) */
+		static TaskScheduler&       Shared();
+
+	private:
+		struct Worker
+		{
+			std::deque<Task>        tasks;
+			std::mutex              mutex;
+			std::thread             thread;
+		};
+
+		/* main loop of the worker identified by _index */
+		void                        run(size_t _index);
+
+		/* Pop a task from the back of _index's queue */
+		bool                        tryPop(size_t _index, Task& _task);
+
+		/* Steal a task from the front of any queue, starting after _index */
+		bool                        trySteal(size_t _index, Task& _task);
+
+		/* Run a task and signal waiters if it was the last one */
+		void                        execute(Task& _task);
+
+		/* Wake up sleeping threads (workers and waiter) */
+		void                        notify();
+
+		std::vector<std::unique_ptr<Worker>> workers;
+		std::atomic<size_t>         pendingCount{0};  /* spawned tasks not finished yet */
+		std::atomic<size_t>         queuedCount{0};   /* spawned tasks not started yet */
+		std::atomic<size_t>         nextQueue{0};     /* round robin for tasks spawned from a non-worker thread */
+		std::atomic<bool>           stopping{false};
+		std::mutex                  sleepMutex;
+		std::condition_variable     sleepCondition;
+
+		static thread_local TaskScheduler* s_currentScheduler; /* scheduler owning the current thread (if a worker) */
+		static thread_local size_t         s_currentWorker;    /* worker index of the current thread (if a worker) */
+	};
+}
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "TokenType.h"
-#include <string>
+#include <string_view>
 
 namespace Nodable {
 
@@ -9,8 +9,9 @@ namespace Nodable {
 	{
 	public:
 		TokenType  type = TokenType::Default; // the type of the token
-		std::string word = "";                // the word as a string
-		size_t      charIndex = 0;                 // the index of the first character of the token in the evaluated expression.
+		std::string_view word;                 // the word, a view into the evaluated expression (no copy, the expression must outlive the token)
+		size_t      charIndex = 0;             // the index of the first character of the token in the evaluated expression.
+		unsigned short precedence = 0;         // for operators only, the precedence of the binary operator (cf. Lexer).
 
 		bool isOperand()const { // TODO: move this into "Parser" or "Language"
 			return type == TokenType::DoubleType ||
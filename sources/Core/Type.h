@@ -10,6 +10,11 @@ namespace Nodable
 		Boolean,
 		Double,
 		String,
+		Int64,
+		Float32,
+		Vec2,    /* 2 x Float32 (cf. Vec.h) */
+		Vec3,
+		Vec4,
 		COUNT
 	};
-}
\ No newline at end of file
+}
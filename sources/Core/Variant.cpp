@@ -1,31 +1,90 @@
 #include "Variant.h"
 #include "Log.h"		 // for LOG_DEBUG(...)
 #include <assert.h>
+#include <cstdio>        // for snprintf
+#include <cstring>       // for memcpy, memmove, strlen, memcmp
+#include <cstdint>
+#include <cmath>         // for std::isnan
+#include <limits>
 
 using namespace Nodable;
 
-Variant::Variant()
+Variant::Variant():
+	storage{},
+	tag((unsigned char)Type::Any)
 {
 }
 
-Variant::~Variant(){};
+Variant::~Variant()
+{
+	release();
+}
 
-Type Variant::getType()const
+Variant::Variant(const Variant& _other)
 {
-    Type result;
+	copy(_other);
+}
 
-	size_t i = data.index();
+Variant::Variant(Variant&& _other) noexcept
+{
+	// the string buffer (if any) is moved with the storage
+	memcpy(storage, _other.storage, StorageSize);
+	tag = _other.tag;
+	_other.tag = (unsigned char)Type::Any;
+}
 
-	if ( i != std::variant_npos )
+Variant& Variant::operator=(const Variant& _other)
+{
+	if (this != &_other)
 	{
-        result = Variant::s_nodableTypeByIndex.at(i);
-    }
+		release();
+		copy(_other);
+	}
+	return *this;
+}
+
+Variant& Variant::operator=(Variant&& _other) noexcept
+{
+	if (this != &_other)
+	{
+		release();
+		memcpy(storage, _other.storage, StorageSize);
+		tag = _other.tag;
+		_other.tag = (unsigned char)Type::Any;
+	}
+	return *this;
+}
+
+void Variant::release()
+{
+	if (isHeap())
+	{
+		char* chars;
+		memcpy(&chars, storage, sizeof(char*));
+		delete[] chars;
+		tag &= TypeMask;
+	}
+}
+
+void Variant::copy(const Variant& _other)
+{
+	if (_other.isHeap())
+	{
+		uint32_t length;
+		memcpy(&length, _other.storage + sizeof(char*), sizeof(uint32_t));
+		tag = (unsigned char)Type::Any;
+		setString((const char*)_other.bytes(), length);
+	}
 	else
-    {
-        result = Type::Any;
-    }
+	{
+		memcpy(storage, _other.storage, StorageSize);
+		tag = _other.tag;
+	}
+}
 
-	return result;
+Type Variant::getType()const
+{
+	return Type(tag & TypeMask);
 }
 
 bool  Variant::isType(Type _type)const
@@ -33,19 +92,169 @@ bool  Variant::isType(Type _type)const
 	return getType() == _type;
 }
 
+void Variant::setDouble(double _value)
+{
+	release();
+	memcpy(storage, &_value, sizeof(double));
+	tag = (unsigned char)Type::Double;
+}
+
+void Variant::setBoolean(bool _value)
+{
+	release();
+	storage[0] = _value;
+	tag = (unsigned char)Type::Boolean;
+}
+
+void Variant::setString(const char* _chars, size_t _length)
+{
+	// _chars can point to this Variant's own string (ex: a view of a part of it),
+	// the previous buffer is freed only once copied, and inline chars can overlap.
+	char* previous = nullptr;
+	if (isHeap())
+		memcpy(&previous, storage, sizeof(char*));
+
+	if (_length <= InlineCapacity)
+	{
+		memmove(storage, _chars, _length);
+		storage[_length] = '\0';
+		tag = (unsigned char)Type::String;
+	}
+	else
+	{
+		auto chars  = new char[_length + 1];
+		auto length = (uint32_t)_length;
+		memcpy(chars, _chars, _length);
+		chars[_length] = '\0';
+		memcpy(storage, &chars, sizeof(char*));
+		memcpy(storage + sizeof(char*), &length, sizeof(uint32_t));
+		tag = (unsigned char)Type::String | HeapFlag;
+	}
+
+	delete[] previous;
+}
+
+void Variant::setInt64(int64_t _value)
+{
+	setBytes(Type::Int64, &_value, sizeof(int64_t));
+}
+
+void Variant::setFloat32(float _value)
+{
+	setBytes(Type::Float32, &_value, sizeof(float));
+}
+
+void Variant::setBytes(Type _type, const void* _value, size_t _size)
+{
+	NODABLE_ASSERT(_size <= StorageSize);
+	release();
+	memcpy(storage, _value, _size);
+	tag = (unsigned char)_type;
+}
+
+const void* Variant::bytes()const
+{
+	if (isHeap())
+	{
+		const char* buffer;
+		memcpy(&buffer, storage, sizeof(char*));
+		return buffer;
+	}
+	return storage;
+}
+
+int64_t Variant::asInt64()const
+{
+	NODABLE_ASSERT(isType(Type::Int64));
+	int64_t value;
+	memcpy(&value, storage, sizeof(int64_t));
+	return value;
+}
+
+float Variant::asFloat32()const
+{
+	NODABLE_ASSERT(isType(Type::Float32));
+	float value;
+	memcpy(&value, storage, sizeof(float));
+	return value;
+}
+
+double Variant::asDouble()const
+{
+	NODABLE_ASSERT(isType(Type::Double));
+	double value;
+	memcpy(&value, storage, sizeof(double));
+	return value;
+}
+
+bool Variant::asBoolean()const
+{
+	NODABLE_ASSERT(isType(Type::Boolean));
+	return storage[0] != 0;
+}
+
+std::string_view Variant::asString()const
+{
+	NODABLE_ASSERT(isType(Type::String));
+
+	if (isHeap())
+	{
+		uint32_t length;
+		memcpy(&length, storage + sizeof(char*), sizeof(uint32_t));
+		return std::string_view((const char*)bytes(), length);
+	}
+
+	auto chars = reinterpret_cast<const char*>(storage);
+	return std::string_view(chars, strlen(chars));
+}
+
+size_t Variant::Format(double _value, char* _buffer)
+{
+	// %f is what std::to_string uses, then we remove any useless ending zeros/dot
+	int length = snprintf(_buffer, FormatBufferSize, "%f", _value);
+	if (length < 0)
+		length = 0;
+	else if ((size_t)length >= FormatBufferSize)
+		length = FormatBufferSize - 1;
+
+	if (memchr(_buffer, '.', length) != nullptr)
+	{
+		while (_buffer[length - 1] == '0')
+			length--;
+		if (_buffer[length - 1] == '.')
+			length--;
+		_buffer[length] = '\0';
+	}
+
+	return length;
+}
+
 void Variant::set(double _var)
 {
 	switch( getType() )
 	{
 		case Type::String:
 		{
-			data.emplace<std::string>( std::to_string(_var) );
+			char buffer[FormatBufferSize];
+			setString(buffer, Format(_var, buffer));
+			break;
+		}
+
+		case Type::Int64:
+		{
+			setInt64(ToInt64(_var));
+			break;
+		}
+
+		case Type::Float32:
+		{
+			setFloat32((float)_var);
 			break;
 		}
 
         default:
 		{
-			data.emplace<double>( _var );
+			setDouble(_var);
 			break;
 		}
 	}
@@ -53,24 +262,12 @@ void Variant::set(double _var)
 
 void Variant::set(const std::string& _var)
 {
-   this->set(_var.c_str());
+	setString(_var.c_str(), _var.size());
 }
 
 void Variant::set(const char* _var)
 {
-    switch (getType())
-    {
-        case Type::String:
-        {
-            data = _var;
-        }
-
-        default:
-        {
-            data = std::string(_var);
-        }
-    }
-
+	setString(_var, strlen(_var));
 }
 
 void Variant::set(bool _var)
@@ -79,19 +276,34 @@ void Variant::set(bool _var)
 	{
 		case Type::String:
 		{
-			data.emplace<std::string>( _var ? "true" : "false" );
+			if (_var)
+				setString("true", 4);
+			else
+				setString("false", 5);
 			break;
 		}
 
 		case Type::Double:
 		{
-			data.emplace<double>( _var ? double(1) : double(0) );
+			setDouble(_var ? double(1) : double(0));
+			break;
+		}
+
+		case Type::Int64:
+		{
+			setInt64(_var ? 1 : 0);
+			break;
+		}
+
+		case Type::Float32:
+		{
+			setFloat32(_var ? 1.0f : 0.0f);
 			break;
 		}
 
 		default:
 		{
-			data.emplace<bool>( _var );
+			setBoolean(_var);
 			break;
 		}
 	}
@@ -105,7 +317,31 @@ bool Variant::isSet()const
 
 void Variant::set(const Variant* _other)
 {
-	data = _other->data;
+	*this = *_other;
+}
+
+bool Variant::operator==(const Variant& _other)const
+{
+	if (getType() != _other.getType())
+		return false;
+
+	switch (getType())
+	{
+		case Type::String:  return asString() == _other.asString();
+		case Type::Double:  return asDouble() == _other.asDouble();
+		case Type::Boolean: return asBoolean() == _other.asBoolean();
+		case Type::Int64:   return asInt64() == _other.asInt64();
+		case Type::Float32: return asFloat32() == _other.asFloat32();
+		case Type::Vec2:    return asVec<2>() == _other.asVec<2>();
+		case Type::Vec3:    return asVec<3>() == _other.asVec<3>();
+		case Type::Vec4:    return asVec<4>() == _other.asVec<4>();
+		default:            return true;
+	}
+}
+
+bool Variant::operator!=(const Variant& _other)const
+{
+	return !(*this == _other);
 }
 
 std::string Variant::getTypeAsString()const
@@ -115,6 +351,11 @@ std::string Variant::getTypeAsString()const
 		case Type::String:		{return "String";}
 		case Type::Double:		{return "Double";}
 		case Type::Boolean: 	{return "Boolean";}
+		case Type::Int64:		{return "Int64";}
+		case Type::Float32:		{return "Float32";}
+		case Type::Vec2:		{return "Vec2";}
+		case Type::Vec3:		{return "Vec3";}
+		case Type::Vec4:		{return "Vec4";}
 		default:				{return "Unknown";}
 	}
 }
@@ -128,16 +369,32 @@ void Variant::setType(Type _type)
 		switch (_type)
 		{
 		case Type::String:
-			data.emplace<std::string>();
+			setString("", 0);
 			break;
 		case Type::Double:
-			data.emplace<double>();
+			setDouble(0.0);
 			break;
 		case Type::Boolean:
-			data.emplace<bool>();
+			setBoolean(false);
+			break;
+		case Type::Int64:
+			setInt64(0);
+			break;
+		case Type::Float32:
+			setFloat32(0.0f);
+			break;
+		case Type::Vec2:
+			setVec(Vec2());
+			break;
+		case Type::Vec3:
+			setVec(Vec3());
+			break;
+		case Type::Vec4:
+			setVec(Vec4());
 			break;
 		default:
-            data.emplace<Any>();
+			release();
+			tag = (unsigned char)Type::Any;
 			break;
 		}
 	}
@@ -153,9 +410,14 @@ Variant::operator double()const
 {
 	switch (getType())
 	{
-		case Type::String:  return double( std::get<std::string>(data).size());
-		case Type::Double:  return std::get<double>(data);
-		case Type::Boolean: return std::get<bool>(data) ? double(1) : double(0);
+		case Type::String:  return double( asString().size());
+		case Type::Double:  return asDouble();
+		case Type::Boolean: return asBoolean() ? double(1) : double(0);
+		case Type::Int64:   return double(asInt64());
+		case Type::Float32: return double(asFloat32());
+		case Type::Vec2:    return double(Length(asVec<2>())); // like a string's size, a vector converts to its length
+		case Type::Vec3:    return double(Length(asVec<3>()));
+		case Type::Vec4:    return double(Length(asVec<4>()));
 		default:           return double(0);
 	}
 }
@@ -163,9 +425,14 @@ Variant::operator double()const
 Variant::operator bool()const {
 	switch (getType())
 	{
-		case Type::String:  return !std::get<std::string>(data).empty();
-		case Type::Double:  return std::get<double>(data) != 0.0F;
-		case Type::Boolean: return std::get<bool>(data);
+		case Type::String:  return !asString().empty();
+		case Type::Double:  return asDouble() != 0.0F;
+		case Type::Boolean: return asBoolean();
+		case Type::Int64:   return asInt64() != 0;
+		case Type::Float32: return asFloat32() != 0.0F;
+		case Type::Vec2:    return asVec<2>() != Vec2();
+		case Type::Vec3:    return asVec<3>() != Vec3();
+		case Type::Vec4:    return asVec<4>() != Vec4();
 		default:           return false;
 	}
 }
@@ -176,27 +443,88 @@ Variant::operator std::string()const {
 	{
 		case Type::String:
 		{
-			return std::get<std::string>(data);
+			return std::string(asString());
 		}
 
 		case Type::Double:
 		{
-			// Format the num as a string without any useless ending zeros/dot
-			std::string str = std::to_string( std::get<double>(data));
-			str.erase(str.find_last_not_of('0') + 1, std::string::npos);
-			if (str.find_last_of('.') + 1 == str.size())
-				str.erase(str.find_last_of('.'), std::string::npos);
-			return str;
+			char buffer[FormatBufferSize];
+			return std::string(buffer, Format(asDouble(), buffer));
 		}
 
 		case Type::Boolean:
 		{
-			return  std::get<bool>(data) ? "true" : "false";
+			return asBoolean() ? "true" : "false";
 		}
 
+		case Type::Int64:
+		{
+			char buffer[32];
+			return std::string(buffer, snprintf(buffer, sizeof(buffer), "%lld", (long long)asInt64()));
+		}
+
+		case Type::Float32:
+		{
+			char buffer[FormatBufferSize];
+			return std::string(buffer, Format(asFloat32(), buffer));
+		}
+
+		case Type::Vec2: return vecToString<2>();
+		case Type::Vec3: return vecToString<3>();
+		case Type::Vec4: return vecToString<4>();
+
 		default:
 		{
 			return "";
 		}
 	}
 }
+
+Variant::operator int64_t()const
+{
+	switch (getType())
+	{
+		case Type::Int64:   return asInt64();
+		case Type::Boolean: return asBoolean() ? 1 : 0;
+		default:            return ToInt64((double)*this);
+	}
+}
+
+int64_t Variant::ToInt64(double _value)
+{
+	// 2^63 is exactly representable as a double, INT64_MAX is not
+	constexpr double limit = 9223372036854775808.0;
+
+	if (std::isnan(_value))
+		return 0;
+	if (_value >= limit)
+		return std::numeric_limits<int64_t>::max();
+	if (_value < -limit)
+		return std::numeric_limits<int64_t>::min();
+	return (int64_t)_value;
+}
+
+Variant::operator float()const
+{
+	if (isType(Type::Float32))
+		return asFloat32();
+	return (float)(double)*this;
+}
+
+template<size_t N>
+std::string Variant::vecToString()const
+{
+	char buffer[FormatBufferSize];
+	auto value = asVec<N>();
+
+	std::string result = "vec" + std::to_string(N) + "(";
+	for (size_t i = 0; i < N; i++)
+	{
+		if (i != 0)
+			result.append(", ");
+		result.append(buffer, Format(value[i], buffer));
+	}
+	result.append(")");
+
+	return result;
+}
@@ -2,22 +2,34 @@
 
 #include "Nodable.h"    // for constants and forward declarations
 #include "Type.h"
+#include "Vec.h"
 #include <string>
-#include <variant>
-#include <array>
+#include <string_view>
+#include <cstdint>
+#include <cstring>       // for memcpy
 
 namespace Nodable{
 
 	/**
 		This class is a variant implementation.
 
-	    It wraps std::variant with a Nodable typing
+		It stores a value of any Nodable type (cf. Type) in 24 bytes:
+		- 23 bytes for the value (a number, a bool, a Vec2/Vec3/Vec4, a short string inline, or a pointer to a longer
+		  string), so only long strings are allocated when copying a Variant,
+		- 1 byte for the type (and a flag to know if the string is stored inline or not).
+
+		Use the typed setters/getters (ex: setDouble(), asDouble()) when the type is known,
+		set()/cast operators convert the value when the types are different.
 	*/
 
 	class Variant {
 	public:
 		Variant();
 		~Variant();
+		Variant(const Variant&);
+		Variant(Variant&&) noexcept;
+		Variant& operator=(const Variant&);
+		Variant& operator=(Variant&&) noexcept;
 
 		bool        isSet()const;
 		bool        isType(Type _type)const;
@@ -30,22 +42,107 @@ namespace Nodable{
 		Type        getType()const;
 		std::string getTypeAsString()const;
 
+		/** Set a value and its type (no conversion, whatever the current type is) */
+		void        setDouble(double);
+		void        setBoolean(bool);
+		void        setString(const char*, size_t _length);
+		void        setInt64(int64_t);
+		void        setFloat32(float);
+
+		template<size_t N>
+		void        setVec(const Vec<N>& _value)
+		{
+			static_assert(sizeof(_value) <= StorageSize, "vectors are expected to be stored inline");
+			setBytes(VecType<N>(), &_value, sizeof(_value));
+		}
+
+		/** Get the value, the Variant must have the right type (no conversion) */
+		double           asDouble()const;
+		bool             asBoolean()const;
+		std::string_view asString()const;
+		int64_t          asInt64()const;
+		float            asFloat32()const;
+
+		template<size_t N>
+		Vec<N>           asVec()const
+		{
+			NODABLE_ASSERT(isType(VecType<N>()));
+			Vec<N> value;
+			memcpy(&value, bytes(), sizeof(value));
+			return value;
+		}
+
+		/** Compare types and values (strings are compared by content) */
+		bool        operator==(const Variant&)const;
+		bool        operator!=(const Variant&)const;
+
         explicit operator int()const;
 		explicit operator double()const;
 		explicit operator bool()const;
 		explicit operator std::string()const;
+		explicit operator int64_t()const;
+		explicit operator float()const;
+
+		/** A vector of the same size is returned as is, a number is copied in each component, zeros otherwise */
+		template<size_t N>
+		explicit operator Vec<N>()const
+		{
+			if (isType(VecType<N>()))
+				return asVec<N>();
+
+			Vec<N> result;
+			if (isType(Type::Double) || isType(Type::Int64) || isType(Type::Float32) || isType(Type::Boolean))
+			{
+				for (auto& each : result.values)
+					each = (float)*this;
+			}
+			return result;
+		}
+
+		/** Get the Type of a Vec<N> */
+		template<size_t N>
+		static constexpr Type VecType()
+		{
+			static_assert(N >= 2 && N <= 4, "Only Vec2, Vec3 and Vec4 are supported");
+			return N == 2 ? Type::Vec2 : N == 3 ? Type::Vec3 : Type::Vec4;
+		}
+
+		/** Write a double to _buffer without any useless ending zeros/dot (ex: 1.5, 10), no allocation.
+		    _buffer must be FormatBufferSize long at least, return the length written. */
+		static size_t Format(double, char* _buffer);
+		static constexpr size_t FormatBufferSize = 512;
+
+		/** Convert a double to an int64 (truncated) without undefined behavior:
+		    NaN gives 0, out of range values are clamped to the int64 limits. */
+		static int64_t ToInt64(double);
 
 	private:
+		/** Free the string buffer (if any), the type is unchanged */
+		void        release();
+
+		/** Copy _other without any check, this must have been released */
+		void        copy(const Variant& _other);
+
+		/** Set a trivially copyable value of a given type (stored inline, _size must be StorageSize at most) */
+		void        setBytes(Type _type, const void* _value, size_t _size);
 
-	    /** Nodable::Type to native type */
-	    constexpr static const std::array<Type, 4> s_nodableTypeByIndex = {{
-	        Type::Any,
-	        Type::Boolean,
-	        Type::Double,
-	        Type::String
-	    }};
+		/** Get the address of the value (inline or in the buffer) */
+		const void* bytes()const;
 
-        typedef void* Any;
-		std::variant<Any, bool, double, std::string> data;
+		/** Write a vector as a string (ex: "vec3(1, 0, 0.5)") */
+		template<size_t N>
+		std::string vecToString()const;
+
+		bool        isHeap()const { return (tag & HeapFlag) != 0; }
+
+		static constexpr size_t        StorageSize    = 23;               /* a Vec4 fits */
+		static constexpr size_t        InlineCapacity = StorageSize - 1;  /* max inline string length (null terminated) */
+		static constexpr unsigned char TypeMask       = 0x0F;
+		static constexpr unsigned char HeapFlag       = 0x10;             /* storage contains a char* and a uint32 length (long String only) */
+
+		alignas(8) unsigned char storage[StorageSize];
+		unsigned char            tag;
 	};
-}
\ No newline at end of file
+
+	static_assert(sizeof(Variant) == 24, "Variant is expected to be 24 bytes long");
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+// std
+#include <cstddef>
+#include <cmath>
+
+namespace Nodable
+{
+	/*
+		A fixed-size vector of N floats (cf. Type::Vec2, Type::Vec3 and Type::Vec4).
+
+		Operations are simple loops over the components, compilers can vectorize them.
+	*/
+	template<size_t N>
+	struct Vec
+	{
+		float values[N] = {};
+
+		float&       operator[](size_t _index)      { return values[_index]; }
+		const float& operator[](size_t _index)const { return values[_index]; }
+	};
+
+	using Vec2 = Vec<2>;
+	using Vec3 = Vec<3>;
+	using Vec4 = Vec<4>;
+
+	template<size_t N>
+	Vec<N> operator+(const Vec<N>& _left, const Vec<N>& _right)
+	{
+		Vec<N> result;
+		for (size_t i = 0; i < N; i++)
+			result.values[i] = _left.values[i] + _right.values[i];
+		return result;
+	}
+
+	template<size_t N>
+	Vec<N> operator-(const Vec<N>& _left, const Vec<N>& _right)
+	{
+		Vec<N> result;
+		for (size_t i = 0; i < N; i++)
+			result.values[i] = _left.values[i] - _right.values[i];
+		return result;
+	}
+
+	template<size_t N>
+	Vec<N> operator-(const Vec<N>& _vec)
+	{
+		Vec<N> result;
+		for (size_t i = 0; i < N; i++)
+			result.values[i] = -_vec.values[i];
+		return result;
+	}
+
+	template<size_t N>
+	Vec<N> operator*(const Vec<N>& _vec, float _factor)
+	{
+		Vec<N> result;
+		for (size_t i = 0; i < N; i++)
+			result.values[i] = _vec.values[i] * _factor;
+		return result;
+	}
+
+	template<size_t N>
+	bool operator==(const Vec<N>& _left, const Vec<N>& _right)
+	{
+		for (size_t i = 0; i < N; i++)
+			if (_left.values[i] != _right.values[i])
+				return false;
+		return true;
+	}
+
+	template<size_t N>
+	bool operator!=(const Vec<N>& _left, const Vec<N>& _right)
+	{
+		return !(_left == _right);
+	}
+
+	template<size_t N>
+	float Dot(const Vec<N>& _left, const Vec<N>& _right)
+	{
+		float result = 0.0f;
+		for (size_t i = 0; i < N; i++)
+			result += _left.values[i] * _right.values[i];
+		return result;
+	}
+
+	template<size_t N>
+	float Length(const Vec<N>& _vec)
+	{
+		return std::sqrt(Dot(_vec, _vec));
+	}
+}
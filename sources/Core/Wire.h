@@ -10,7 +10,7 @@ namespace Nodable
 	{
 	public:
 
-	    Wire(): Node("Wire") {} // TODO: delete dependency with Node.
+	    explicit Wire(Arena* _arena = nullptr): Node("Wire", _arena) {} // TODO: delete dependency with Node.
 	    ~Wire(){}
 
 		enum State_
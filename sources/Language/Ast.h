@@ -0,0 +1,99 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "Nodable.h"    // forward declarations
+#include "Type.h"
+#include "Variant.h"
+
+namespace Nodable{
+
+	class Function;
+
+	/*
+		The role of this class is to store the Abstract Syntax Tree of an expression.
+
+		The Parser builds an Ast from tokens, validates it (types, functions and operators are resolved)
+		and only then lowers it to a Nodable graph (Nodes and Wires in a Container).
+		This way, a wrong expression never leaves a partially built graph.
+
+		Nodes are stored contiguously and reference each other by index (no allocation per node).
+		A node is always added after its children: iterating nodes by index is a post-order traversal,
+		so no pass over the tree needs recursion.
+	*/
+
+	class Ast
+	{
+	public:
+		using Index = uint32_t;
+		static constexpr Index InvalidIndex = UINT32_MAX;
+
+		enum class Kind: unsigned char
+		{
+			Literal,         // Boolean, Double or String token
+			Variable,        // Symbol token
+			BinaryOperation, // Operator token
+			UnaryOperation,  // Operator token
+			FunctionCall,    // Symbol token (followed by an Operator token for function-like operators)
+			Constant         // a value computed while parsing (cf. Parser optimizations)
+		};
+
+		struct Node
+		{
+			Kind            kind;
+			Type            type       = Type::Any; // result type, resolved during validation
+			Index           tokenId    = 0;         // the token the node comes from (cf. Parser::tokens)
+			Index           firstChild = 0;         // index of the first child in children
+			Index           childCount = 0;
+			const Function* function   = nullptr;   // operations and function calls only, resolved during validation
+			Index           constant   = 0;         // Constant only, index of the value (cf. getConstant())
+		};
+
+		Ast() = default;
+		~Ast() = default;
+
+		/* Add a node (children must have been added before) and return its index */
+		Index add(Kind _kind, size_t _tokenId, const Index* _children = nullptr, size_t _childCount = 0)
+		{
+			Node node;
+			node.kind       = _kind;
+			node.tokenId    = (Index)_tokenId;
+			node.firstChild = (Index)children.size();
+			node.childCount = (Index)_childCount;
+			children.insert(children.end(), _children, _children + _childCount);
+			nodes.push_back(node);
+			return Index(nodes.size() - 1);
+		}
+
+		/* Turn a node into a Constant with a given value (its children are no longer referenced) */
+		void setConstant(Index _index, const Variant& _value)
+		{
+			auto& node      = nodes[_index];
+			node.kind       = Kind::Constant;
+			node.childCount = 0;
+			node.function   = nullptr;
+			node.constant   = (Index)constants.size();
+			constants.push_back(_value);
+		}
+
+		Node&          at(Index _index)                 { return nodes[_index]; }
+		const Node&    at(Index _index)const            { return nodes[_index]; }
+		Index*         childrenOf(const Node& _node)    { return children.data() + _node.firstChild; }
+		const Index*   childrenOf(const Node& _node)const { return children.data() + _node.firstChild; }
+		const Variant& getConstant(const Node& _node)const { return constants[_node.constant]; }
+		size_t         size()const                      { return nodes.size(); }
+
+		/* Remove all nodes, memory is kept to build the next tree */
+		void clear()
+		{
+			nodes.clear();
+			children.clear();
+			constants.clear();
+		}
+
+	private:
+		std::vector<Node>    nodes;
+		std::vector<Index>   children;
+		std::vector<Variant> constants;
+	};
+}
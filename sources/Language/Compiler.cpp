@@ -0,0 +1,236 @@
+#include "Compiler.h"
+#include "Container.h"
+#include "ComputeFunction.h"
+#include "Function.h"
+#include "Language.h"
+#include "Member.h"
+#include "Variable.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace Nodable;
+
+/*
+	Native functions (cf. LanguageNodable) and their equivalent instruction.
+	A function matches if it is the one Language::Nodable() registered for this signature
+	and if its Member types are the same (another Language's "sin" is never compiled).
+*/
+struct CompilableFunction
+{
+	const char* identifier;
+	size_t      argCount;
+	OpCode      code;
+	Type        resultType;
+	Type        argType;
+};
+
+static const CompilableFunction s_compilableFunctions[] = {
+	{ "operator+"  , 2, OpCode::Add           , Type::Double , Type::Double  },
+	{ "operator-"  , 2, OpCode::Subtract      , Type::Double , Type::Double  },
+	{ "operator-"  , 1, OpCode::Negate        , Type::Double , Type::Double  },
+	{ "operator*"  , 2, OpCode::Multiply      , Type::Double , Type::Double  },
+	{ "operator/"  , 2, OpCode::Divide        , Type::Double , Type::Double  },
+	{ "operator="  , 2, OpCode::Copy          , Type::Double , Type::Double  },
+	{ "operator="  , 2, OpCode::CopyBoolean   , Type::Boolean, Type::Boolean },
+	{ "operator>"  , 2, OpCode::Greater       , Type::Boolean, Type::Double  },
+	{ "operator>=" , 2, OpCode::GreaterOrEqual, Type::Boolean, Type::Double  },
+	{ "operator<"  , 2, OpCode::Less          , Type::Boolean, Type::Double  },
+	{ "operator<=" , 2, OpCode::LessOrEqual   , Type::Boolean, Type::Double  },
+	{ "operator==" , 2, OpCode::Equal         , Type::Boolean, Type::Double  },
+	{ "operator!"  , 1, OpCode::Not           , Type::Boolean, Type::Boolean },
+	{ "operator&&" , 2, OpCode::And           , Type::Boolean, Type::Boolean },
+	{ "operator||" , 2, OpCode::Or            , Type::Boolean, Type::Boolean },
+	{ "operator=>" , 2, OpCode::Implies       , Type::Boolean, Type::Boolean },
+	{ "operator<=>", 2, OpCode::Equivalent    , Type::Boolean, Type::Boolean },
+	{ "returnNumber",1, OpCode::Copy          , Type::Double , Type::Double  },
+	{ "sin"        , 1, OpCode::Sine          , Type::Double , Type::Double  },
+	{ "cos"        , 1, OpCode::Cosine        , Type::Double , Type::Double  },
+	{ "sqrt"       , 1, OpCode::SquareRoot    , Type::Double , Type::Double  },
+	{ "add"        , 2, OpCode::Add           , Type::Double , Type::Double  },
+	{ "minus"      , 2, OpCode::Subtract      , Type::Double , Type::Double  },
+	{ "mult"       , 2, OpCode::Multiply      , Type::Double , Type::Double  },
+	{ "mod"        , 2, OpCode::Modulo        , Type::Double , Type::Double  },
+	{ "pow"        , 2, OpCode::Power         , Type::Double , Type::Double  },
+	{ "not"        , 1, OpCode::Not           , Type::Boolean, Type::Boolean },
+	{ "and"        , 2, OpCode::And           , Type::Boolean, Type::Boolean },
+	{ "or"         , 2, OpCode::Or            , Type::Boolean, Type::Boolean },
+	{ "xor"        , 2, OpCode::Xor           , Type::Boolean, Type::Boolean },
+	{ "bool"       , 1, OpCode::ToBoolean     , Type::Boolean, Type::Double  },
+};
+
+/* Resolve each compilable function to the Function(s) registered by Language::Nodable() */
+static std::unordered_map<const Function*, const CompilableFunction*> ResolveCompilableFunctions()
+{
+	std::unordered_map<const Function*, const CompilableFunction*> result;
+	auto language = Language::Nodable();
+
+	for (const auto& each : s_compilableFunctions)
+	{
+		FunctionSignature signature(each.identifier, language->typeToTokenType(each.resultType));
+		for (size_t i = 0; i < each.argCount; i++)
+			signature.pushArg(language->typeToTokenType(each.argType));
+
+		// Operators are registered twice: as operators (operation nodes) and in the api (function calls)
+		auto function = language->findFunction(signature);
+		auto op       = language->findOperator(signature);
+		if (function)
+			result[function] = &each;
+		if (op)
+			result[op] = &each;
+		if (function == nullptr && op == nullptr)
+			LOG_WARNING(0u, "Compiler: %s is not registered by the Nodable language, it will not be compiled.\n", each.identifier);
+	}
+
+	return result;
+}
+
+static const CompilableFunction* FindCompilableFunction(const Function* _function)
+{
+	static const auto s_compilableFunctionsByFunction = ResolveCompilableFunctions();
+
+	auto found = s_compilableFunctionsByFunction.find(_function);
+	return found != s_compilableFunctionsByFunction.end() ? found->second : nullptr;
+}
+
+Compiler::Compiler(Container* _container):
+	container(_container)
+{
+}
+
+bool Compiler::compile(Program& _program)
+{
+	program = &_program;
+	program->clear();
+	registers.clear();
+
+	bool success = true;
+
+	for (auto node : container->getSchedule())
+	{
+		if (auto variable = dynamic_cast<Variable*>(node))
+		{
+			success = compileVariable(variable);
+		}
+		else if (auto compute = node->getComponent<ComputeFunction>())
+		{
+			success = compileFunction(compute);
+		}
+		else
+		{
+			success = false;
+		}
+
+		if (!success)
+		{
+			LOG_MESSAGE(1u, "Compiler::compile(): unable to compile %s, graph will be evaluated node by node.\n", node->getLabel());
+			program->clear();
+			break;
+		}
+	}
+
+	LOG_MESSAGE(1u, "Compiler::compile() done (%i instructions).\n", (int)program->getInstructionCount());
+
+	program = nullptr;
+	return success;
+}
+
+bool Compiler::compileVariable(Variable* _variable)
+{
+	auto member = _variable->getMember();
+	Register reg;
+
+	// An undefined variable can only be assigned (ex: "a = 5"), its readers will fail to find its register.
+	if (!member->hasInputConnected() && member->isType(Type::Any))
+		return true;
+
+	if (!readRegister(member, reg))
+		return false;
+
+	registers[member] = reg;
+	if (member->hasInputConnected())
+		program->bindOutput(member, reg.index, reg.type);
+
+	return true;
+}
+
+bool Compiler::compileFunction(const ComputeFunction* _compute)
+{
+	auto function = _compute->getFunction();
+	auto& args    = _compute->getArgs();
+	auto result   = _compute->getResult();
+
+	if (result == nullptr || args.size() > 2 || std::find(args.begin(), args.end(), nullptr) != args.end())
+		return false;
+
+	// Find the instruction matching with the function
+	auto found = FindCompilableFunction(function);
+	if (found == nullptr || found->argCount != args.size() || !result->isType(found->resultType))
+		return false;
+
+	// Assign sets its left operand (its own Member, not the source) so we only need to read the right one.
+	bool isAssign = found->identifier == std::string_view("operator=");
+
+	// Get operands, their types must be the instruction's ones
+	Register operands[2];
+	for (size_t i = isAssign ? 1 : 0; i < args.size(); i++)
+	{
+		if (!readRegister(args[i], operands[i]) || operands[i].type != found->argType)
+			return false;
+	}
+
+	if (isAssign)
+	{
+		operands[0] = { program->newRegister(operands[1].type), operands[1].type };
+		program->push(found->code, operands[0].index, operands[1].index);
+	}
+
+	// An input connected operand will receive the value of its source
+	for (size_t i = 0; i < args.size(); i++)
+	{
+		registers[args[i]] = operands[i];
+		if ((isAssign && i == 0) || args[i]->hasInputConnected())
+			program->bindOutput(args[i], operands[i].index, operands[i].type);
+	}
+
+	// Compute result
+	Register resultRegister{ program->newRegister(found->resultType), found->resultType };
+	if (isAssign)
+		program->push(found->code, resultRegister.index, operands[1].index);
+	else
+		program->push(found->code, resultRegister.index, operands[0].index, operands[1].index);
+
+	registers[result] = resultRegister;
+	program->bindOutput(result, resultRegister.index, resultRegister.type);
+
+	return true;
+}
+
+bool Compiler::readRegister(Member* _member, Register& _reg)
+{
+	if (auto source = _member->getInputMember())
+	{
+		// The source must be compiled first (not the case within a cycle or from another container)
+		auto found = registers.find(source);
+		if (found == registers.end())
+			return false;
+
+		_reg = found->second; // like Member::updateValueFromInputMemberValue(), the type is the source's one.
+	}
+	else
+	{
+		if (!IsCompilable(_member))
+			return false;
+
+		_reg = { program->newRegister(_member->getType()), _member->getType() };
+		program->bindInput(_member, _reg.index, _reg.type);
+	}
+
+	return true;
+}
+
+bool Compiler::IsCompilable(const Member* _member)
+{
+	return _member->isType(Type::Double) || _member->isType(Type::Boolean);
+}
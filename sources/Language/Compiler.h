@@ -0,0 +1,53 @@
+#pragma once
+
+// std
+#include <unordered_map>
+
+// Nodable
+#include "Nodable.h"    // forward declarations
+#include "Program.h"
+
+namespace Nodable{
+
+	/*
+		The role of this class is to lower a Container graph into a Program.
+
+		Nodes are visited following the Container's schedule (inputs first), each Member gets a register:
+		- an input connected Member shares the register of its source (no copy needed),
+		- a Member without input is loaded from its value at each run.
+
+		Only numeric and boolean operations/functions are supported, compile() fails on any other node
+		(ex: strings) and the Container keeps evaluating its graph node by node.
+	*/
+	class Compiler
+	{
+	public:
+		explicit Compiler(Container* _container);
+		~Compiler() = default;
+
+		/* Compile the whole graph into _program.
+		   Return false if a node can't be compiled (_program is left empty). */
+		bool compile(Program& _program);
+
+	private:
+		bool compileVariable(Variable*);
+		bool compileFunction(const ComputeFunction*);
+
+		/* A register index in the bank of a given type */
+		struct Register
+		{
+			unsigned int index = 0;
+			Type         type  = Type::Any;
+		};
+
+		/* Get (or create) the register to read _member's value, false if it is not possible */
+		bool readRegister(Member* _member, Register& _reg);
+
+		/* true if _member type can be stored in a register */
+		static bool IsCompilable(const Member* _member);
+
+		Container*                                      container;
+		Program*                                        program = nullptr;
+		std::unordered_map<const Member*, Register>     registers;
+	};
+}
@@ -28,6 +28,7 @@ namespace Nodable
 		void        insert(std::regex, TokenType);
 		void        insert(std::string, TokenType);
 		const auto& getTokenTypeToRegexMap()const { return tokenTypeToRegex;  }
+		const auto& getTokenTypeToStringMap()const { return tokenTypeToString; }
 	private:
 		std::string numbers;
 		std::string letters;
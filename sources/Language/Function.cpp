@@ -2,6 +2,11 @@
 
 using namespace Nodable;
 
+static size_t HashCombine(size_t _seed, size_t _value)
+{
+	return _seed ^ (_value + 0x9e3779b9 + (_seed << 6) + (_seed >> 2));
+}
+
 FunctionArg::FunctionArg(TokenType _type, std::string _name) {
 	type = _type;
 	name = _name;
@@ -9,6 +14,7 @@ FunctionArg::FunctionArg(TokenType _type, std::string _name) {
 
 FunctionSignature::FunctionSignature(std::string _identifier, TokenType _type, std::string _label) :
 	identifier(_identifier),
+	identifierHash(std::hash<std::string>{}(_identifier)),
 	type(_type),
 	label(_label)
 {
@@ -46,11 +52,24 @@ const std::string& FunctionSignature::getIdentifier()const
 	return this->identifier;
 }
 
-const std::vector<FunctionArg> FunctionSignature::getArgs() const
+const std::vector<FunctionArg>& FunctionSignature::getArgs() const
 {
 	return this->args;
 }
 
+size_t FunctionSignature::getHash()const
+{
+	return HashCombine(identifierHash, args.size());
+}
+
+size_t FunctionSignature::getOverloadHash()const
+{
+	size_t hash = getHash();
+	for (const auto& each : args)
+		hash = HashCombine(hash, (size_t)each.type);
+	return hash;
+}
+
 const TokenType FunctionSignature::getType() const
 {
 	return type;
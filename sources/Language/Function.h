@@ -15,7 +15,14 @@ namespace Nodable {
      *
 	 * TODO: try to replace Member* by Variant*
 	 */
-	typedef std::function <int (Member*, const std::vector<Member*>&)> FunctionImplem;
+	typedef int (*FunctionImplem)(Member*, const std::vector<Member*>&);
+
+	/*
+	 * A C++ function pointer with its type erased, and the function able to call it knowing its type.
+	 * (cf. NativeFunction.h and Language::addToAPI(R(*)(Args...), ...))
+	 */
+	typedef void (*NativePointer)();
+	typedef int  (*NativeThunk)(NativePointer, Member*, const std::vector<Member*>&);
 
 	/*
 	 * Simple object to store a function argument (token, name)
@@ -44,13 +51,20 @@ namespace Nodable {
 
 		bool                           match(const FunctionSignature& _other)const;
 		const std::string&             getIdentifier()const;
-		const std::vector<FunctionArg> getArgs() const;
+		const std::vector<FunctionArg>& getArgs() const;
 		const TokenType               getType() const;
 		const std::string              getLabel() const;
 
+		/* Hash of the identifier and the argument count (all overloads of a function share the same hash) */
+		size_t                         getHash()const;
+
+		/* Hash of the identifier and each argument type (identifies one overload) */
+		size_t                         getOverloadHash()const;
+
 	private:
 		std::string label;
 		std::string identifier;
+		size_t      identifierHash;
 		std::vector<FunctionArg> args;
 		TokenType type;
 
@@ -79,9 +93,32 @@ namespace Nodable {
 			implementation(_implementation)
 		{}
 
+		Function(
+			FunctionSignature _signature,
+			NativeThunk       _thunk,
+			NativePointer     _native):
+
+			signature(_signature),
+			implementation(nullptr),
+			thunk(_thunk),
+			native(_native)
+		{}
+
 		~Function() {}
 
+		/* Call the function with some arguments and store its result into _result. Return 0 if succeeded. */
+		int call(Member* _result, const std::vector<Member*>& _args)const
+		{
+			return thunk != nullptr ? thunk(native, _result, _args) : implementation(_result, _args);
+		}
+
+		bool isCallable()const { return thunk != nullptr || implementation != nullptr; }
+
 		FunctionImplem    implementation;
 		FunctionSignature signature;
+		NativeThunk       thunk  = nullptr; /* native functions only (implementation is nullptr) */
+		NativePointer     native = nullptr;
+		bool              pure = false; /* no side effect and same result for same arguments: can be folded and memoized,
+		                                   set at registration (cf. Language::addToAPI()) */
 	};
 }
\ No newline at end of file
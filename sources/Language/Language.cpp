@@ -19,14 +19,19 @@ const Language* Language::Nodable() {
 
 void Language::addOperator( Operator _operator)
 {
+	auto index = operators.size();
+	operatorsBySignature[_operator.signature.getHash()].push_back(index);
+	operatorsByIdentifier[std::hash<std::string_view>{}(_operator.identifier)].push_back(index);
 	operators.push_back(_operator);
 }
 
 void Language::addOperator( std::string       _identifier,
                             unsigned short    _precedence,
                             FunctionSignature _prototype,
-                            FunctionImplem  _implementation) {
+                            FunctionImplem    _implementation,
+                            bool              _pure) {
 	Operator op(_identifier, _precedence, _prototype, _implementation);
+	op.pure = _pure;
 	addOperator(op);
 }
 
@@ -34,56 +39,67 @@ bool  Language::hasHigherPrecedenceThan(const Operator* _firstOperator, const Op
 	return _firstOperator->precedence >= _secondOperator->precedence;
 }
 
-const Function* Nodable::Language::findFunction(const FunctionSignature& _signature) const
+template<typename T>
+const T* Language::Find(const std::vector<T>& _all, const Index& _index, Cache& _cache, const FunctionSignature& _signature)
 {
-	auto predicate = [&](Function fct) {
-		return fct.signature.match(_signature);
-	};
-
-	auto it = std::find_if(api.begin(), api.end(), predicate);
-
-	if (it != api.end())
-		return &*it;
+	auto overloadHash = _signature.getOverloadHash();
+
+	// same overload as last time ?
+	auto cached = _cache.find(overloadHash);
+	if (cached != _cache.end() && _all[cached->second].signature.match(_signature))
+		return &_all[cached->second];
+
+	// otherwise, check each overload (same identifier and arity) in declaration order
+	auto overloads = _index.find(_signature.getHash());
+	if (overloads == _index.end())
+		return nullptr;
+
+	for (auto each : overloads->second)
+	{
+		if (_all[each].signature.match(_signature))
+		{
+			_cache[overloadHash] = each;
+			return &_all[each];
+		}
+	}
 
 	return nullptr;
 }
 
-const Operator* Language::findOperator(const std::string& _identifier) const {
+const Function* Nodable::Language::findFunction(const FunctionSignature& _signature) const
+{
+	return Find(api, apiBySignature, apiCache, _signature);
+}
 
-	auto predicate = [&](Operator op) {
-		return op.identifier == _identifier;
-	};
+const Operator* Language::findOperator(std::string_view _identifier) const {
 
-	auto it = std::find_if(operators.cbegin(), operators.cend(), predicate);
+	auto found = operatorsByIdentifier.find(std::hash<std::string_view>{}(_identifier));
+	if (found == operatorsByIdentifier.end())
+		return nullptr;
 
-	if (it != operators.end())
-		return &*it;
+	for (auto each : found->second)
+	{
+		if (operators[each].identifier == _identifier)
+			return &operators[each];
+	}
 
 	return nullptr;
 }
 
 const Operator* Language::findOperator(const FunctionSignature& _signature) const {
-	
-	auto predicate = [&](Operator op) {
-		return op.signature.match(_signature);
-	};
-
-	auto it = std::find_if(operators.cbegin(), operators.cend(), predicate );
-
-	if ( it != operators.end() )
-		return &*it;
-
-	return nullptr;
+	return Find(operators, operatorsBySignature, operatorsCache, _signature);
 }
 
 
 void Nodable::Language::addToAPI(Function _function)
 {
+	apiBySignature[_function.signature.getHash()].push_back(api.size());
 	this->api.push_back(_function);
 }
 
-void Nodable::Language::addToAPI(FunctionSignature& _signature, FunctionImplem _implementation)
+void Nodable::Language::addToAPI(FunctionSignature& _signature, FunctionImplem _implementation, bool _pure)
 {
 	Function f(_signature, _implementation);
-	this->api.push_back(f);
+	f.pure = _pure;
+	addToAPI(f);
 }
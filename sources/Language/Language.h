@@ -2,9 +2,11 @@
 
 // std
 #include <map>
+#include <unordered_map>
 #include <functional>
 #include <tuple>
 #include <regex>
+#include <string_view>
 
 // Nodable
 #include "Nodable.h"   // for constants and forward declarations
@@ -18,7 +20,10 @@
 /*
 	Here, some Macros to easily create function and add them to the Language.api
 
-	TODO: I don't like these big macros. Use function traits instead.
+	Plain C++ functions should rather be added with Language::addToAPI(R(*)(Args...), ...) (cf. NativeFunction.h),
+	these macros are for operators and functions that can fail or need to access the Members.
+
+	FCT_END and OPERATOR_END take the purity of the function (Pure or Impure, cf. Function::pure).
 */
 #define RETURN_SUCCESS return 0;
 
@@ -27,15 +32,9 @@ _result->setType(Type::Any); /* We intentionnaly force result type any to avoid
 return 1;
 
 #define ARG(n) (*_args[n])
+/* argument types are checked once by the Parser, not on each call */
 #define BEGIN_IMPL\
-	auto implementation = [](Member* _result, const std::vector<Member*>& _args)->int { \
-	for(auto it = _args.begin(); it != _args.end(); it++) \
-	{\
-		if( (*it)->isType(Type::Any) ) \
-		{\
-			LOG_WARNING( 1u, "Argument %i (%s) is unknown.\n", std::distance(_args.begin(), it), (*it)->getName().c_str() );\
-		}\
-	}
+	FunctionImplem implementation = [](Member* _result, const std::vector<Member*>& _args)->int {
 
 #define RETURN( expr )\
 	_result->set( expr );
@@ -65,15 +64,15 @@ return 1;
 	auto signature = FunctionSignature::Create( _type, _identifier, __VA_ARGS__); \
 	BEGIN_IMPL
 
-#define FCT_END \
+#define FCT_END( _pure ) \
 	END_IMPL \
-	addToAPI( signature, implementation );\
+	addToAPI( signature, implementation, _pure );\
 }
 
-#define OPERATOR_END \
+#define OPERATOR_END( _pure ) \
 	END_IMPL \
-	addOperator(identifier, precedence, signature, implementation);\
-	addToAPI( signature , implementation );\
+	addOperator(identifier, precedence, signature, implementation, _pure);\
+	addToAPI( signature , implementation, _pure );\
 }
 
 namespace Nodable {
@@ -122,14 +121,25 @@ namespace Nodable {
 		void                                  addOperator(std::string       _identifier,
 			                                              unsigned short    _precedence,
 			                                              FunctionSignature _prototype,
-			                                              FunctionImplem  _implementation);
+			                                              FunctionImplem    _implementation,
+			                                              bool              _pure = false);
 		const Function*                       findFunction(const FunctionSignature& signature) const;
 		const Operator*                       findOperator(const FunctionSignature& _operator) const;
-		const Operator*                       findOperator(const std::string& _identifier) const;
+		const Operator*                       findOperator(std::string_view _identifier) const;
 		void                                  addToAPI(Function);
-		void                                  addToAPI(FunctionSignature&, FunctionImplem);
+		void                                  addToAPI(FunctionSignature&, FunctionImplem, bool _pure = false);
+
+		/* Add a C++ function, its signature is deduced from its type (ex: addToAPI(&MyFunction, "myFunction", Pure)).
+		   Defined in NativeFunction.h (to include to use it). */
+		template<typename R, typename... Args>
+		void                                  addToAPI(R (*_function)(Args...), const std::string& _identifier, bool _pure = false, const std::string& _label = "");
+
+		/* Purity of the registered functions (cf. Function::pure), functions are impure unless told otherwise */
+		static constexpr bool                 Pure   = true;
+		static constexpr bool                 Impure = false;
 		bool                                  hasHigherPrecedenceThan(const Operator *_firstOperator, const Operator* _secondOperator)const;
 		const std::vector<Function>&          getAllFunctions()const { return api; }		
+		const std::vector<Operator>&          getAllOperators()const { return operators; }
 		
 
 		/**
@@ -147,9 +157,25 @@ namespace Nodable {
 	public:
 		Dictionnary dictionnary;
 	private:
+		/* Functions and operators are indexed by FunctionSignature::getHash() (identifier and arity),
+		   an index is a list of positions in api/operators in the order they were added. */
+		using Index = std::unordered_map<size_t, std::vector<size_t>>;
+
+		/* Last overload found for a FunctionSignature::getOverloadHash() (checked with match() before use).
+		   Mutable since filled by const find methods, a Language must not be used by several parsers at once. */
+		using Cache = std::unordered_map<size_t, size_t>;
+
+		template<typename T>
+		static const T*                       Find(const std::vector<T>&, const Index&, Cache&, const FunctionSignature&);
+
 		std::string name;
 		std::vector<Operator> operators;
 		std::vector<Function> api;
+		Index                 apiBySignature;
+		Index                 operatorsBySignature;
+		Index                 operatorsByIdentifier;  /* by std::hash<std::string_view>() of the identifier */
+		mutable Cache         apiCache;
+		mutable Cache         operatorsCache;
 	};
 
 }
@@ -1,12 +1,26 @@
 #include "LanguageNodable.h"
 #include "Member.h"
+#include "NativeFunction.h"
 #include <time.h>
 #include "IconsFontAwesome5.h"
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <iostream>
 
 using namespace Nodable;
 
+/* int64 arithmetic wraps around on overflow (two's complement) instead of being undefined */
+static int64_t WrappingAdd(int64_t _a, int64_t _b)      { return (int64_t)((uint64_t)_a + (uint64_t)_b); }
+static int64_t WrappingSubtract(int64_t _a, int64_t _b) { return (int64_t)((uint64_t)_a - (uint64_t)_b); }
+static int64_t WrappingMultiply(int64_t _a, int64_t _b) { return (int64_t)((uint64_t)_a * (uint64_t)_b); }
+
+/* int64 division (or remainder) traps for a zero divisor and for INT64_MIN / -1 (the quotient does not fit) */
+static bool IsDivisionValid(int64_t _a, int64_t _b)
+{
+	return _b != 0 && !(_a == std::numeric_limits<int64_t>::min() && _b == -1);
+}
+
 std::string LanguageNodable::serialize(
 	const FunctionSignature&   _signature,
 	std::vector<Member*> _args) const
@@ -142,13 +156,18 @@ LanguageNodable::LanguageNodable(): Language("Nodable")
 	// Setup dictionnary:
 	dictionnary.insert(std::regex("^(true|false)")       , TokenType::Boolean );
 	dictionnary.insert(std::regex("^(\"[a-zA-Z0-9 ]+\")"), TokenType::String );
-	dictionnary.insert(std::regex("^[a-zA-Z_]+")         , TokenType::Symbol);
+	dictionnary.insert(std::regex("^[a-zA-Z_][a-zA-Z_0-9]*"), TokenType::Symbol);
 	dictionnary.insert(std::regex("^(0|([1-9][0-9]*))(\\.[0-9]+)?") , TokenType::Double);
 
 	dictionnary.insert("bool"  , TokenType::BooleanType);
 	dictionnary.insert("string", TokenType::StringType);
 	dictionnary.insert("number", TokenType::DoubleType);
 	dictionnary.insert("any"   , TokenType::AnyType);
+	dictionnary.insert("int"   , TokenType::Int64Type);
+	dictionnary.insert("float" , TokenType::Float32Type);
+	dictionnary.insert("vec2"  , TokenType::Vec2Type);
+	dictionnary.insert("vec3"  , TokenType::Vec3Type);
+	dictionnary.insert("vec4"  , TokenType::Vec4Type);
 
 	dictionnary.insert( 
 		std::regex("^(&&|[|][|]|==|>|<(?!(=))|<=>|=>|=(?!(>|=))|<=(?!(>))|>=|[+]|[-]|[/]|[*]|[!])"),
@@ -167,6 +186,8 @@ LanguageNodable::LanguageNodable(): Language("Nodable")
 	auto Double = TokenType::DoubleType;
 	auto Bool   = TokenType::BooleanType;
 	auto Str    = TokenType::StringType;
+	auto Int    = TokenType::Int64Type;
+	auto Float  = TokenType::Float32Type;
 
 	////////////////////////////////
 	//
@@ -174,88 +195,46 @@ LanguageNodable::LanguageNodable(): Language("Nodable")
 	//
 	///////////////////////////////
 
-	// returnNumber(number)
-
-	FCT_BEGIN(Double, "returnNumber", Double)
-		RETURN( (double)ARG(0) )
-	FCT_END
-
-	// sin(number)
-	FCT_BEGIN(Double, "sin", Double)
-		RETURN( sin((double)ARG(0)) )
-	FCT_END
-
-	// cos(number)
-	FCT_BEGIN(Double, "cos", Double)
-		RETURN( cos((double)ARG(0)) )
-	FCT_END
-
-	// add(number)
-	FCT_BEGIN(Double, "add", Double, Double)
-		RETURN((double)ARG(0) + (double)ARG(1))
-	FCT_END
-
-	// minus(number)
-	FCT_BEGIN(Double, "minus", Double, Double)
-		RETURN( (double)ARG(0) - (double)ARG(1))
-	FCT_END
-
-	// mult(number)
-	FCT_BEGIN(Double, "mult", Double, Double)
-		RETURN( (double)ARG(0) * (double)ARG(1))
-	FCT_END
-
-	// sqrt(number)
-	FCT_BEGIN(Double, "sqrt", Double)
-		RETURN( sqrt((double)ARG(0)) )
-	FCT_END
-
-	// not(boolean)
-	FCT_BEGIN(Bool, "not", Bool)
-		RETURN( !(bool)ARG(0) )
-	FCT_END
-
-	// or(boolean, boolean)
-	FCT_BEGIN(Bool, "or", Bool, Bool)
-		RETURN( (bool)ARG(0) || ARG(1))
-	FCT_END
-	
-	// and(boolean, boolean)
-	FCT_BEGIN(Bool, "and", Bool, Bool)
-		RETURN( (bool)ARG(0) && ARG(1))
-	FCT_END
-
-	// xor(boolean, boolean)
-	FCT_BEGIN(Bool, "xor", Bool, Bool)
-		RETURN(
-		( (bool)ARG(0) && !(bool)ARG(1)) ||
-		(!(bool)ARG(0) &&  (bool)ARG(1)) )
-	FCT_END
-	
-	// boolean bool(number)
-	FCT_BEGIN(Bool, "bool", Double)
-		RETURN( (bool)ARG(0))
-	FCT_END
+	// Native functions, signatures are deduced from C++ types (cf. NativeFunction.h)
+
+	addToAPI(+[](double _x) { return _x; }, "returnNumber", Pure);
+	addToAPI(+[](double _x) { return std::sin(_x); }, "sin", Pure);
+	addToAPI(+[](double _x) { return std::cos(_x); }, "cos", Pure);
+	addToAPI(+[](double _a, double _b) { return _a + _b; }, "add", Pure);
+	addToAPI(+[](double _a, double _b) { return _a - _b; }, "minus", Pure);
+	addToAPI(+[](double _a, double _b) { return _a * _b; }, "mult", Pure);
+	addToAPI(+[](double _x) { return std::sqrt(_x); }, "sqrt", Pure);
+	addToAPI(+[](bool _a) { return !_a; }, "not", Pure);
+	addToAPI(+[](bool _a, bool _b) { return _a || _b; }, "or", Pure);
+	addToAPI(+[](bool _a, bool _b) { return _a && _b; }, "and", Pure);
+	addToAPI(+[](bool _a, bool _b) { return _a != _b; }, "xor", Pure);
+	addToAPI(+[](double _x) { return _x != 0.0; }, "bool", Pure);
 
     // string string(number)
     FCT_BEGIN(Str, "string", Double)
             RETURN( (std::string)ARG(0))
-    FCT_END
+    FCT_END(Pure)
 
     // string string(boolean)
     FCT_BEGIN(Str, "string", Bool)
         RETURN(ARG(0) ? "true" : "false" );
-    FCT_END
+    FCT_END(Pure)
+
+	// mod(number, number), remainder of the integer parts: NaN for a zero divisor, never traps (same as OpCode::Modulo)
+	addToAPI(+[](double _x, double _y) { return std::fmod(std::trunc(_x), std::trunc(_y)); }, "mod", Pure);
 
-	// mod(number, number)
-	FCT_BEGIN(Double, "mod", Double, Double)
-		RETURN( (int)ARG(0) % (int)ARG(1) )
-	FCT_END
+	addToAPI(+[](double _x) { return Variant::ToInt64(_x); }, "int", Pure); // NaN gives 0, out of range values are clamped
+	addToAPI(+[](double _x) { return (float)_x; }, "float", Pure);
+	addToAPI(+[](int64_t _x) { return (double)_x; }, "number", Pure);
+	addToAPI(+[](float _x) { return (double)_x; }, "number", Pure);
 
-	// pow(number)
-	FCT_BEGIN(Double, "pow", Double, Double)
-		RETURN( pow((double)ARG(0), (double)ARG(1)) )
-	FCT_END
+	// int mod(int, int)
+	FCT_BEGIN(Int, "mod", Int, Int)
+		if (!IsDivisionValid((int64_t)ARG(0), (int64_t)ARG(1))) { RETURN_FAILED }
+		RETURN( (int64_t)ARG(0) % (int64_t)ARG(1) )
+	FCT_END(Pure)
+
+	addToAPI(+[](double _x, double _y) { return std::pow(_x, _y); }, "pow", Pure);
 	
 	// secondDegreePolynomial(a: number, x: number, b:number, y:number, c:number)
 	FCT_BEGIN(Double, "secondDegreePolynomial", Double, Double, Double, Double, Double)
@@ -264,7 +243,7 @@ LanguageNodable::LanguageNodable(): Language("Nodable")
 			(double)ARG(2) * (double)ARG(3) +            // by +
 			(double)ARG(4);                              // c
 	RETURN(value)
-	FCT_END
+	FCT_END(Pure)
 
 	// DNAtoProtein(string)
 	FCT_BEGIN(Str, "DNAtoProtein", Str)
@@ -346,7 +325,7 @@ LanguageNodable::LanguageNodable(): Language("Nodable")
 		}
 
 		RETURN( protein )
-	FCT_END
+	FCT_END(Pure)
 	
 
 	////////////////////////////////
@@ -358,106 +337,253 @@ LanguageNodable::LanguageNodable(): Language("Nodable")
 	// operator+(number, number)
 	BINARY_OP_BEGIN(Double, "+", Double, Double, 10u, ICON_FA_PLUS " Add")
 		RETURN( (double)ARG(0) + (double)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator+(number, number)
 	BINARY_OP_BEGIN(Str, "+", Str, Str, 10u, "Concat.")
 	RETURN((std::string)ARG(0) + (std::string)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator+(number, number)
 	BINARY_OP_BEGIN(Str, "+", Str, Double, 10u, "Concat.")
 	RETURN((std::string)ARG(0) + (std::string)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// bool operator||(bool, bool)
 	BINARY_OP_BEGIN(Bool, "||", Bool, Bool, 10u, "Logical Or")
 	RETURN((bool)ARG(0) || (bool)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// bool operator&&(bool, bool)
 	BINARY_OP_BEGIN(Bool, "&&", Bool, Bool, 10u, "Logical And")
 	RETURN((bool)ARG(0) && (bool)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator-(number, number)	
 	BINARY_OP_BEGIN(Double, "-", Double, Double, 10u, ICON_FA_MINUS " Subtract")
 		RETURN( (double)ARG(0) - (double)ARG(1) )
-	OPERATOR_END
+	OPERATOR_END(Pure)
 	
 	// operator/(number, number)
 	BINARY_OP_BEGIN(Double, "/", Double, Double, 20u, ICON_FA_DIVIDE " Divide");
 		RETURN( (double)ARG(0) / (double)ARG(1) )
-	OPERATOR_END
+	OPERATOR_END(Pure)
 	
 
 	// operator*(number, number)
 	BINARY_OP_BEGIN(Double, "*", Double, Double, 20u, ICON_FA_TIMES " Multiply")
 		RETURN( (double)ARG(0) * (double)ARG(1) )
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator!(boolean)
 	UNARY_OP_BEGIN(Bool, "!", Bool, 5u, "! not")
 		RETURN( !(bool)ARG(0) )
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator-(number)
 	UNARY_OP_BEGIN(Double, "-", Double, 5u, ICON_FA_MINUS " Minus")
 		RETURN( -(double)ARG(0) )
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// number operator=(number, number)
 	BINARY_OP_BEGIN(Double, "=", Double, Double, 0u, ICON_FA_EQUALS " Assign")
 		_args[0]->set(ARG(1));
 		RETURN((double)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Impure)
 
     // string operator=(string, string)
     BINARY_OP_BEGIN(Str, "=", Str, Str, 0u, ICON_FA_EQUALS " Assign")
             _args[0]->set(ARG(1));
             RETURN((std::string)ARG(1))
-    OPERATOR_END
+    OPERATOR_END(Impure)
 
 	// bool operator=(bool, bool)
 	BINARY_OP_BEGIN(Bool, "=", Bool, Bool, 0u, ICON_FA_EQUALS " Assign")
 			_args[0]->set(ARG(1));
 			RETURN((bool)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Impure)
 
 	// bool operator=>(bool, bool)
 	BINARY_OP_BEGIN(Bool, "=>", Bool, Bool, 10u, "=> Implies")
 		RETURN(!(bool)ARG(0) || (bool)ARG(1) )
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator>=(double, double)
 	BINARY_OP_BEGIN(Bool, ">=", Double, Double, 10u, ">= Greater or equal")
 		RETURN((double)ARG(0) >= (double)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator<=(double, double)
 	BINARY_OP_BEGIN(Bool, "<=", Double, Double, 10u, "<= Less or equal")
 		RETURN((double)ARG(0) <= (double)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator==(double, double)
 	BINARY_OP_BEGIN(Bool, "==", Double, Double, 10u, "== Equals")
 		RETURN((double)ARG(0) == (double)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator<=>(bool, bool)
 	BINARY_OP_BEGIN(Bool, "<=>", Bool, Bool, 10u, "<=> Equivalent")
 	RETURN((double)ARG(0) == (double)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator>(bool, bool)
 	BINARY_OP_BEGIN(Bool, ">", Double, Double, 10u, "> Greater")
 		RETURN((double)ARG(0) > (double)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
 
 	// operator<(bool, bool)
 	BINARY_OP_BEGIN(Bool, "<", Double, Double,10u, "< Less")
 		RETURN((double)ARG(0) < (double)ARG(1))
-	OPERATOR_END
+	OPERATOR_END(Pure)
+
+	// int operators (no double round-trip)
+
+	BINARY_OP_BEGIN(Int, "+", Int, Int, 10u, ICON_FA_PLUS " Add")
+		RETURN( WrappingAdd((int64_t)ARG(0), (int64_t)ARG(1)) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Int, "-", Int, Int, 10u, ICON_FA_MINUS " Subtract")
+		RETURN( WrappingSubtract((int64_t)ARG(0), (int64_t)ARG(1)) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Int, "*", Int, Int, 20u, ICON_FA_TIMES " Multiply")
+		RETURN( WrappingMultiply((int64_t)ARG(0), (int64_t)ARG(1)) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Int, "/", Int, Int, 20u, ICON_FA_DIVIDE " Divide")
+		if (!IsDivisionValid((int64_t)ARG(0), (int64_t)ARG(1))) { RETURN_FAILED }
+		RETURN( (int64_t)ARG(0) / (int64_t)ARG(1) )
+	OPERATOR_END(Pure)
+
+	UNARY_OP_BEGIN(Int, "-", Int, 5u, ICON_FA_MINUS " Minus")
+		RETURN( WrappingSubtract(0, (int64_t)ARG(0)) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Int, "=", Int, Int, 0u, ICON_FA_EQUALS " Assign")
+		_args[0]->set(ARG(1));
+		RETURN( (int64_t)ARG(1) )
+	OPERATOR_END(Impure)
+
+	BINARY_OP_BEGIN(Bool, ">", Int, Int, 10u, "> Greater")
+		RETURN( (int64_t)ARG(0) > (int64_t)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Bool, "<", Int, Int, 10u, "< Less")
+		RETURN( (int64_t)ARG(0) < (int64_t)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Bool, ">=", Int, Int, 10u, ">= Greater or equal")
+		RETURN( (int64_t)ARG(0) >= (int64_t)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Bool, "<=", Int, Int, 10u, "<= Less or equal")
+		RETURN( (int64_t)ARG(0) <= (int64_t)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Bool, "==", Int, Int, 10u, "== Equals")
+		RETURN( (int64_t)ARG(0) == (int64_t)ARG(1) )
+	OPERATOR_END(Pure)
+
+	// float operators
+
+	BINARY_OP_BEGIN(Float, "+", Float, Float, 10u, ICON_FA_PLUS " Add")
+		_result->setFloat32( (float)ARG(0) + (float)ARG(1) );
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Float, "-", Float, Float, 10u, ICON_FA_MINUS " Subtract")
+		_result->setFloat32( (float)ARG(0) - (float)ARG(1) );
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Float, "*", Float, Float, 20u, ICON_FA_TIMES " Multiply")
+		_result->setFloat32( (float)ARG(0) * (float)ARG(1) );
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Float, "/", Float, Float, 20u, ICON_FA_DIVIDE " Divide")
+		_result->setFloat32( (float)ARG(0) / (float)ARG(1) );
+	OPERATOR_END(Pure)
+
+	UNARY_OP_BEGIN(Float, "-", Float, 5u, ICON_FA_MINUS " Minus")
+		_result->setFloat32( -(float)ARG(0) );
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Float, "=", Float, Float, 0u, ICON_FA_EQUALS " Assign")
+		_args[0]->set(ARG(1));
+		_result->setFloat32( (float)ARG(1) );
+	OPERATOR_END(Impure)
+
+	BINARY_OP_BEGIN(Bool, ">", Float, Float, 10u, "> Greater")
+		RETURN( (float)ARG(0) > (float)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Bool, "<", Float, Float, 10u, "< Less")
+		RETURN( (float)ARG(0) < (float)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Bool, ">=", Float, Float, 10u, ">= Greater or equal")
+		RETURN( (float)ARG(0) >= (float)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Bool, "<=", Float, Float, 10u, "<= Less or equal")
+		RETURN( (float)ARG(0) <= (float)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Bool, "==", Float, Float, 10u, "== Equals")
+		RETURN( (float)ARG(0) == (float)ARG(1) )
+	OPERATOR_END(Pure)
+
+	// vectors
+
+	addVectorAPI<2>(TokenType::Vec2Type);
+	addVectorAPI<3>(TokenType::Vec3Type);
+	addVectorAPI<4>(TokenType::Vec4Type);
+}
+
+template<size_t N>
+void LanguageNodable::addVectorAPI(TokenType _vecType)
+{
+	auto Double = TokenType::DoubleType;
+	auto Float  = TokenType::Float32Type;
+	auto Vec    = _vecType;
+	auto name   = "vec" + std::to_string(N);
+
+	// vecN vecN(number, ...)
+	{
+		FunctionSignature signature(name, Vec);
+		for (size_t i = 0; i < N; i++)
+			signature.pushArg(Double);
+
+		BEGIN_IMPL
+			Nodable::Vec<N> value;
+			for (size_t i = 0; i < N; i++)
+				value[i] = (float)ARG(i);
+			RETURN(value)
+		FCT_END(Pure)
+
+	addToAPI(+[](Nodable::Vec<N> _a, Nodable::Vec<N> _b) { return Dot(_a, _b); }, "dot", Pure);
+	addToAPI(+[](Nodable::Vec<N> _a) { return Length(_a); }, "length", Pure);
+
+	BINARY_OP_BEGIN(Vec, "+", Vec, Vec, 10u, ICON_FA_PLUS " Add")
+		RETURN( (Nodable::Vec<N>)ARG(0) + (Nodable::Vec<N>)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Vec, "-", Vec, Vec, 10u, ICON_FA_MINUS " Subtract")
+		RETURN( (Nodable::Vec<N>)ARG(0) - (Nodable::Vec<N>)ARG(1) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Vec, "*", Vec, Double, 20u, ICON_FA_TIMES " Multiply")
+		RETURN( (Nodable::Vec<N>)ARG(0) * (float)ARG(1) )
+	OPERATOR_END(Pure)
+
+	UNARY_OP_BEGIN(Vec, "-", Vec, 5u, ICON_FA_MINUS " Minus")
+		RETURN( -(Nodable::Vec<N>)ARG(0) )
+	OPERATOR_END(Pure)
+
+	BINARY_OP_BEGIN(Vec, "=", Vec, Vec, 0u, ICON_FA_EQUALS " Assign")
+		_args[0]->set(ARG(1));
+		RETURN( (Nodable::Vec<N>)ARG(1) )
+	OPERATOR_END(Impure)
 }
 
 const TokenType LanguageNodable::typeToTokenType(Type _type)const
@@ -468,6 +594,11 @@ const TokenType LanguageNodable::typeToTokenType(Type _type)const
 	case Type::Boolean: return TokenType::BooleanType;
 	case Type::Double:  return TokenType::DoubleType;
 	case Type::String:  return TokenType::StringType;
+	case Type::Int64:   return TokenType::Int64Type;
+	case Type::Float32: return TokenType::Float32Type;
+	case Type::Vec2:    return TokenType::Vec2Type;
+	case Type::Vec3:    return TokenType::Vec3Type;
+	case Type::Vec4:    return TokenType::Vec4Type;
 	default:
 		return TokenType::AnyType;
 		break;
@@ -482,6 +613,11 @@ const Type LanguageNodable::tokenTypeToType(TokenType _tokenType)const
 	case TokenType::BooleanType: return Type::Boolean;
 	case TokenType::DoubleType:  return Type::Double;
 	case TokenType::StringType:  return Type::String;
+	case TokenType::Int64Type:   return Type::Int64;
+	case TokenType::Float32Type: return Type::Float32;
+	case TokenType::Vec2Type:    return Type::Vec2;
+	case TokenType::Vec3Type:    return Type::Vec3;
+	case TokenType::Vec4Type:    return Type::Vec4;
 	default:
 		return Type::Any;
 		break;
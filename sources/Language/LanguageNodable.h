@@ -21,6 +21,11 @@ namespace Nodable {
 		virtual const FunctionSignature createUnaryOperatorSignature(Type, std::string, Type) const;
 		virtual const TokenType typeToTokenType(Type _type)const;
 		virtual const Type tokenTypeToType(TokenType _tokenType)const;
+
+	private:
+		/* Add the constructor, functions and operators of a vector type (vec2, vec3 or vec4) */
+		template<size_t N>
+		void addVectorAPI(TokenType _vecType);
 	};
 }
 
@@ -0,0 +1,205 @@
+#include "Lexer.h"
+#include "Language.h"
+#include <algorithm>
+#include <cstring>     // for strncmp
+
+using namespace Nodable;
+
+Lexer::Lexer(const Language* _language)
+{
+	for (auto c : {' ', '\t', '\r', '\n'})
+		charClasses[(unsigned char)c] = CharClass::Space;
+
+	for (int c = 'a'; c <= 'z'; c++)
+		charClasses[c] = CharClass::Letter;
+
+	for (int c = 'A'; c <= 'Z'; c++)
+		charClasses[c] = CharClass::Letter;
+
+	charClasses['_'] = CharClass::Letter;
+
+	for (int c = '0'; c <= '9'; c++)
+		charClasses[c] = CharClass::Digit;
+
+	charClasses['"'] = CharClass::Quote;
+
+	// single char words of the dictionnary (brackets, separator, etc.)
+	for (const auto& pair : _language->dictionnary.getTokenTypeToStringMap())
+	{
+		auto c = (unsigned char)pair.second.front();
+		if (pair.second.size() == 1 && charClasses[c] == CharClass::Unknown)
+		{
+			charClasses[c]  = CharClass::Punctuation;
+			punctuations[c] = pair.first;
+		}
+	}
+
+	// operators, binary ones first: an identifier shared by binary and unary operators (ex: "-")
+	// takes the precedence of its first binary operator.
+	for (auto binary : {true, false})
+	{
+		for (const auto& each : _language->getAllOperators())
+		{
+			auto isBinary = each.getType() == Operator::Type::Binary;
+			auto found    = std::find_if(operators.begin(), operators.end(), [&](const OperatorEntry& _entry) {
+				return _entry.identifier == each.identifier;
+			});
+
+			if (isBinary == binary && found == operators.end())
+			{
+				operators.push_back({each.identifier, binary ? each.precedence : (unsigned short)0});
+				auto c = (unsigned char)each.identifier.front();
+				if (charClasses[c] == CharClass::Unknown)
+					charClasses[c] = CharClass::Operator;
+			}
+		}
+	}
+
+	// longest first
+	std::stable_sort(operators.begin(), operators.end(), [](const OperatorEntry& a, const OperatorEntry& b) {
+		return a.identifier.size() > b.identifier.size();
+	});
+}
+
+const Lexer::OperatorEntry* Lexer::matchOperator(const char* _chars, size_t _available)const
+{
+	for (const auto& each : operators)
+	{
+		auto length = each.identifier.size();
+		if (length <= _available && strncmp(_chars, each.identifier.c_str(), length) == 0)
+			return &each;
+	}
+	return nullptr;
+}
+
+bool Lexer::tokenize(const std::string& _expression, std::vector<Token>& _tokens)const
+{
+	size_t cursor = 0;
+	return tokenize(_expression, cursor, _tokens, false);
+}
+
+bool Lexer::tokenizeStatement(const std::string& _expression, size_t& _cursor, std::vector<Token>& _tokens)const
+{
+	return tokenize(_expression, _cursor, _tokens, true);
+}
+
+bool Lexer::tokenize(const std::string& _expression, size_t& _cursor, std::vector<Token>& _tokens, bool _singleStatement)const
+{
+	const char*  chars = _expression.c_str();
+	const size_t end   = _expression.size();
+	size_t&      i     = _cursor;
+
+	auto isDigit = [&](size_t _index) { return _index < end && charClasses[(unsigned char)chars[_index]] == CharClass::Digit; };
+
+	auto addToken = [&](TokenType _type, size_t _first, size_t _length, size_t _charIndex) {
+		_tokens.emplace_back();
+		auto& token     = _tokens.back();
+		token.type      = _type;
+		token.word      = std::string_view(chars + _first, _length);
+		token.charIndex = _charIndex;
+	};
+
+	while (i < end)
+	{
+		const size_t start = i;
+
+		// comments (single line or multi line)
+		if (chars[i] == '/' && i + 1 < end && (chars[i + 1] == '/' || chars[i + 1] == '*'))
+		{
+			if (chars[i + 1] == '/')
+			{
+				while (i < end && chars[i] != '\n')
+					i++;
+			}
+			else
+			{
+				auto close = _expression.find("*/", i + 2);
+				if (close == std::string::npos)
+					return false;
+				i = close + 2;
+			}
+			continue;
+		}
+
+		switch (charClasses[(unsigned char)chars[i]])
+		{
+			case CharClass::Space:
+			{
+				i++;
+				break;
+			}
+
+			case CharClass::Letter:
+			{
+				while (i < end && (charClasses[(unsigned char)chars[i]] == CharClass::Letter || isDigit(i)))
+					i++;
+
+				auto length = i - start;
+				auto isBoolean = (length == 4 && strncmp(chars + start, "true", 4) == 0) ||
+				                 (length == 5 && strncmp(chars + start, "false", 5) == 0);
+				addToken(isBoolean ? TokenType::Boolean : TokenType::Symbol, start, length, start);
+				break;
+			}
+
+			case CharClass::Digit:
+			{
+				// "0" or "[1-9][0-9]*", then an optional decimal part ".[0-9]+"
+				if (chars[i] == '0')
+					i++;
+				else
+					while (isDigit(i)) i++;
+
+				if (i < end && chars[i] == '.' && isDigit(i + 1))
+				{
+					i++;
+					while (isDigit(i)) i++;
+				}
+
+				addToken(TokenType::Double, start, i - start, start);
+				break;
+			}
+
+			case CharClass::Quote:
+			{
+				// the token word is the string without its quotes
+				i++;
+				while (i < end && chars[i] != '"' && chars[i] != '\n')
+					i++;
+
+				if (i == end || chars[i] != '"')
+					return false;
+
+				addToken(TokenType::String, start + 1, i - start - 1, start);
+				i++;
+				break;
+			}
+
+			case CharClass::Punctuation:
+			{
+				addToken(punctuations[(unsigned char)chars[i]], start, 1, start);
+				i++;
+
+				if (_singleStatement && _tokens.back().type == TokenType::EndOfInstruction)
+					return true;
+				break;
+			}
+
+			case CharClass::Operator:
+			{
+				auto entry = matchOperator(chars + i, end - i);
+				if (entry == nullptr)
+					return false;
+
+				addToken(TokenType::Operator, start, entry->identifier.size(), start);
+				_tokens.back().precedence = entry->precedence;
+				i += entry->identifier.size();
+				break;
+			}
+
+			default:
+				return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <array>
+
+#include "Nodable.h"    // forward declarations
+#include "TokenType.h"
+#include "Token.h"
+
+namespace Nodable{
+
+	/*
+		The role of this class is to cut a code string into Tokens (cf. Parser).
+
+		Tokenization is done in a single pass over the characters, without any regular expression:
+		each character is classified with a lookup table, and the class decides which rule applies
+		(number, string, symbol, operator, punctuation, comment or space).
+
+		Operators and punctuation are read from the Language (cf. Language::getAllOperators() and Dictionnary),
+		operators are matched using the longest identifier first (ex: ">=" is never read as ">" then "=").
+		Operator tokens get their binary precedence from a table built once, so the Parser never looks them up.
+	*/
+
+	class Lexer
+	{
+	public:
+		explicit Lexer(const Language* _language);
+		~Lexer() = default;
+
+		/* Cut _expression into tokens and append them to _tokens.
+		   Token words are views into _expression (nothing is copied).
+		   Return false if a character is not part of the language. */
+		bool tokenize(const std::string& _expression, std::vector<Token>& _tokens)const;
+
+		/* Same as tokenize() but stop after the first end of instruction token (ex: ";").
+		   Start at _cursor (a char index in _expression) and move it after the last char read,
+		   _cursor == _expression.size() once the whole expression is read. */
+		bool tokenizeStatement(const std::string& _expression, size_t& _cursor, std::vector<Token>& _tokens)const;
+
+	private:
+		enum class CharClass: unsigned char
+		{
+			Unknown,
+			Space,
+			Letter,      // first char of a symbol or a boolean
+			Digit,
+			Quote,
+			Punctuation, // brackets, separator, end of instruction
+			Operator     // first char of an operator
+		};
+
+		struct OperatorEntry
+		{
+			std::string    identifier;
+			unsigned short precedence;
+		};
+
+		bool tokenize(const std::string& _expression, size_t& _cursor, std::vector<Token>& _tokens, bool _singleStatement)const;
+
+		/* Return the longest operator starting at _chars, nullptr if none */
+		const OperatorEntry* matchOperator(const char* _chars, size_t _available)const;
+
+		std::array<CharClass, 256> charClasses{};
+		std::array<TokenType, 256> punctuations{};
+
+		/* Operators sorted from the longest identifier to the shortest */
+		std::vector<OperatorEntry> operators;
+	};
+}
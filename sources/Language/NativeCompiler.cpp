@@ -0,0 +1,183 @@
+#include "NativeCompiler.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NODABLE_NATIVE_CODE
+#include <dlfcn.h>
+#include <fcntl.h>      // for open
+#include <stdlib.h>     // for mkdtemp
+#include <unistd.h>     // for write, close
+#endif
+
+using namespace Nodable;
+
+NativeCompiler::NativeCompiler(std::string _command)
+	: command(std::move(_command))
+{
+}
+
+bool NativeCompiler::IsSupported()
+{
+#ifdef NODABLE_NATIVE_CODE
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::string NativeCompiler::GenerateSource(const Program& _program)
+{
+	std::string source;
+	source.reserve(64 + _program.getInstructionCount() * 32);
+	source += "#include <cmath>\n";
+	source += "extern \"C\" void ";
+	source += EntryPoint;
+	source += "(double* n, unsigned char* b)\n{\n";
+
+	char line[128];
+	for (const auto& i : _program.getInstructions())
+	{
+		const char* format = nullptr;
+		switch (i.code)
+		{
+		case OpCode::Copy:           format = "\tn[%u] = n[%u];\n";                              break;
+		case OpCode::Negate:         format = "\tn[%u] = -n[%u];\n";                             break;
+		case OpCode::SquareRoot:     format = "\tn[%u] = std::sqrt(n[%u]);\n";                   break;
+		case OpCode::Sine:           format = "\tn[%u] = std::sin(n[%u]);\n";                    break;
+		case OpCode::Cosine:         format = "\tn[%u] = std::cos(n[%u]);\n";                    break;
+		case OpCode::Add:            format = "\tn[%u] = n[%u] + n[%u];\n";                      break;
+		case OpCode::Subtract:       format = "\tn[%u] = n[%u] - n[%u];\n";                      break;
+		case OpCode::Multiply:       format = "\tn[%u] = n[%u] * n[%u];\n";                      break;
+		case OpCode::Divide:         format = "\tn[%u] = n[%u] / n[%u];\n";                      break;
+		case OpCode::Modulo:         format = "\tn[%u] = std::fmod(std::trunc(n[%u]), std::trunc(n[%u]));\n"; break;
+		case OpCode::Power:          format = "\tn[%u] = std::pow(n[%u], n[%u]);\n";             break;
+		case OpCode::Greater:        format = "\tb[%u] = n[%u] >  n[%u];\n";                     break;
+		case OpCode::GreaterOrEqual: format = "\tb[%u] = n[%u] >= n[%u];\n";                     break;
+		case OpCode::Less:           format = "\tb[%u] = n[%u] <  n[%u];\n";                     break;
+		case OpCode::LessOrEqual:    format = "\tb[%u] = n[%u] <= n[%u];\n";                     break;
+		case OpCode::Equal:          format = "\tb[%u] = n[%u] == n[%u];\n";                     break;
+		case OpCode::ToBoolean:      format = "\tb[%u] = n[%u] != 0.0;\n";                       break;
+		case OpCode::CopyBoolean:    format = "\tb[%u] = b[%u];\n";                              break;
+		case OpCode::Not:            format = "\tb[%u] = !b[%u];\n";                             break;
+		case OpCode::And:            format = "\tb[%u] = b[%u] && b[%u];\n";                     break;
+		case OpCode::Or:             format = "\tb[%u] = b[%u] || b[%u];\n";                     break;
+		case OpCode::Xor:            format = "\tb[%u] = b[%u] != b[%u];\n";                     break;
+		case OpCode::Implies:        format = "\tb[%u] = !b[%u] || b[%u];\n";                    break;
+		case OpCode::Equivalent:     format = "\tb[%u] = b[%u] == b[%u];\n";                     break;
+		}
+
+		// unary formats ignore the last operand
+		snprintf(line, sizeof(line), format, i.dst, i.a, i.b);
+		source += line;
+	}
+
+	source += "}\n";
+	return source;
+}
+
+NativeCompiler::Result NativeCompiler::build(const std::string& _source)const
+{
+	Result native;
+
+#ifdef NODABLE_NATIVE_CODE
+	namespace fs = std::filesystem;
+
+	std::error_code error;
+	auto temp = fs::temp_directory_path(error);
+	if (error)
+		return native;
+
+	// a private directory (mode 0700) with a unique name, no other user can write (or replace) the files
+	// compiled and loaded from it
+	auto directoryTemplate = (temp / "nodable-XXXXXX").string();
+	if (mkdtemp(directoryTemplate.data()) == nullptr)
+	{
+		LOG_WARNING(0u, "NativeCompiler::build(): unable to create a directory in %s.\n", temp.c_str());
+		return native;
+	}
+
+	fs::path directory  = directoryTemplate;
+	auto     sourcePath = directory / "program.cpp";
+	auto     libPath    = directory / "program.so";
+
+	auto removeDirectory = [&]() { fs::remove_all(directory, error); };
+
+	// the file must not exist yet, its content is written by us only
+	{
+		int  file    = open(sourcePath.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0600);
+		bool written = file != -1 && write(file, _source.data(), _source.size()) == (ssize_t)_source.size();
+		if (file != -1)
+			close(file);
+
+		if (!written)
+		{
+			LOG_WARNING(0u, "NativeCompiler::build(): unable to write %s.\n", sourcePath.c_str());
+			removeDirectory();
+			return native;
+		}
+	}
+
+	auto commandLine = command + " -O2 -shared -fPIC -o \"" + libPath.string() + "\" \"" + sourcePath.string() + "\" > /dev/null 2>&1";
+	auto result      = std::system(commandLine.c_str());
+
+	if (result != 0)
+	{
+		LOG_WARNING(0u, "NativeCompiler::build(): unable to compile with \"%s\", instructions will be interpreted.\n", command.c_str());
+		removeDirectory();
+		return native;
+	}
+
+	// the library stays mapped once loaded, the files are no longer needed
+	auto handle = dlopen(libPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+	removeDirectory();
+
+	if (handle == nullptr)
+	{
+		LOG_WARNING(0u, "NativeCompiler::build(): unable to load the library (%s).\n", dlerror());
+		return native;
+	}
+
+	auto code = reinterpret_cast<Program::NativeCode>(dlsym(handle, EntryPoint));
+	if (code == nullptr)
+	{
+		dlclose(handle);
+		return native;
+	}
+
+	native.code    = code;
+	native.library = std::shared_ptr<void>(handle, [](void* _handle) { dlclose(_handle); });
+	return native;
+#else
+	LOG_MESSAGE(1u, "NativeCompiler::build(): native code is not supported on this platform.\n");
+	return native;
+#endif
+}
+
+bool NativeCompiler::compile(Program& _program)const
+{
+	auto native = build(GenerateSource(_program));
+	if (native.code == nullptr)
+		return false;
+
+	_program.setNativeCode(native.code, native.library);
+	LOG_MESSAGE(1u, "NativeCompiler::compile() done (%i instructions).\n", (int)_program.getInstructionCount());
+	return true;
+}
+
+std::future<NativeCompiler::Result> NativeCompiler::compileAsync(const Program& _program)const
+{
+	// the source is generated now, the thread does not access the Program (it can change or be deleted meanwhile)
+	std::packaged_task<Result()> task([compiler = *this, source = GenerateSource(_program)]() {
+		return compiler.build(source);
+	});
+	auto result = task.get_future();
+
+	// detached: unlike std::async's, this future does not wait for the thread when it is destroyed
+	std::thread(std::move(task)).detach();
+	return result;
+}
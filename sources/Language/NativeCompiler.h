@@ -0,0 +1,62 @@
+#pragma once
+
+// std
+#include <string>
+#include <memory>
+#include <future>
+
+// Nodable
+#include "Nodable.h"    // forward declarations
+#include "Program.h"
+
+namespace Nodable{
+
+	/*
+		The role of this class is to turn a Program into native code.
+
+		Instructions are emitted as a C++ translation unit (one statement per instruction, registers are arrays),
+		which is compiled by the system compiler into a shared library, then loaded (dlopen) and attached
+		to the Program (cf. Program::setNativeCode()).
+
+		This takes the time of a C++ compilation, so it is only worth it for graphs evaluated many times,
+		and compileAsync() lets the Program be interpreted meanwhile.
+		On failure (no compiler, platform without dlopen, etc.) the Program is left unchanged and keeps
+		interpreting its instructions.
+	*/
+	class NativeCompiler
+	{
+	public:
+		/* _command is the C++ compiler to call (ex: "c++", "clang++") */
+		explicit NativeCompiler(std::string _command = "c++");
+		~NativeCompiler() = default;
+
+		/* Native code built from a Program's instructions, code is nullptr if the compilation failed */
+		struct Result
+		{
+			Program::NativeCode   code = nullptr;
+			std::shared_ptr<void> library;          // keeps the code loaded
+		};
+
+		/* Compile and load _program's instructions, return false if it is not possible */
+		bool compile(Program& _program)const;
+
+		/* Compile and load _program's instructions on another thread, _program is left untouched.
+		   The Result can be attached with Program::setNativeCode() if the instructions have not changed since. */
+		std::future<Result> compileAsync(const Program& _program)const;
+
+		/* Generate the C++ source code of _program's instructions */
+		static std::string GenerateSource(const Program& _program);
+
+		/* true if native code can be loaded on this platform */
+		static bool IsSupported();
+
+		/* Name of the function defined by the generated source (cf. Program::NativeCode) */
+		static constexpr const char* EntryPoint = "nodable_execute";
+
+	private:
+		/* Compile and load _source (cf. GenerateSource()), can be called from any thread */
+		Result build(const std::string& _source)const;
+
+		std::string command;
+	};
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>       // for std::index_sequence
+#include <type_traits>   // for std::decay_t
+
+#include "Nodable.h"    // forward declarations
+#include "Function.h"
+#include "Language.h"
+#include "Member.h"
+#include "Vec.h"
+
+/*
+	Here, the binding of C++ functions to a Language (cf. Language::addToAPI(R(*)(Args...), ...)).
+
+	The FunctionSignature is deduced from the C++ function type, and a thunk is generated for this type:
+	arguments are read from the Members' Variants with their expected type (no conversion), the function is
+	called directly, and its return value is stored into the result Member. No lambda per function and no
+	std::function. Argument types are checked before the call (cf. Parser, ComputeFunction).
+
+	ex: language->addToAPI(+[](double _x) { return std::sin(_x); }, "sin", Language::Pure);
+*/
+
+namespace Nodable {
+
+	/* How a C++ type is declared in a FunctionSignature, read from an argument and written to a result */
+	template<typename T>
+	struct NativeType;
+
+	template<>
+	struct NativeType<double>
+	{
+		static constexpr TokenType tokenType = TokenType::DoubleType;
+		static double get(const Member* _member)         { return _member->getData().asDouble(); }
+		static void   set(Member* _member, double _value) { _member->set(_value); }
+	};
+
+	template<>
+	struct NativeType<bool>
+	{
+		static constexpr TokenType tokenType = TokenType::BooleanType;
+		static bool get(const Member* _member)       { return _member->getData().asBoolean(); }
+		static void set(Member* _member, bool _value) { _member->set(_value); }
+	};
+
+	template<>
+	struct NativeType<std::string>
+	{
+		static constexpr TokenType tokenType = TokenType::StringType;
+		static std::string get(const Member* _member)                     { return std::string(_member->getData().asString()); }
+		static void        set(Member* _member, const std::string& _value) { _member->set(_value); }
+	};
+
+	template<>
+	struct NativeType<int64_t>
+	{
+		static constexpr TokenType tokenType = TokenType::Int64Type;
+		static int64_t get(const Member* _member)          { return _member->getData().asInt64(); }
+		static void    set(Member* _member, int64_t _value) { _member->set(_value); }
+	};
+
+	template<>
+	struct NativeType<float>
+	{
+		static constexpr TokenType tokenType = TokenType::Float32Type;
+		static float get(const Member* _member)        { return _member->getData().asFloat32(); }
+		static void  set(Member* _member, float _value) { _member->setFloat32(_value); }
+	};
+
+	template<size_t N>
+	struct NativeVecType
+	{
+		static constexpr TokenType tokenType = N == 2 ? TokenType::Vec2Type : N == 3 ? TokenType::Vec3Type : TokenType::Vec4Type;
+		static Vec<N> get(const Member* _member)                { return _member->getData().template asVec<N>(); }
+		static void   set(Member* _member, const Vec<N>& _value) { _member->set(_value); }
+	};
+
+	template<> struct NativeType<Vec<2>>: NativeVecType<2> {};
+	template<> struct NativeType<Vec<3>>: NativeVecType<3> {};
+	template<> struct NativeType<Vec<4>>: NativeVecType<4> {};
+
+	/* Call a function of a known type, arguments are read in order from _args */
+	template<typename R, typename... Args, size_t... I>
+	int CallNative(R (*_function)(Args...), Member* _result, const std::vector<Member*>& _args, std::index_sequence<I...>)
+	{
+		NativeType<std::decay_t<R>>::set(_result, _function(NativeType<std::decay_t<Args>>::get(_args[I])...));
+		return 0;
+	}
+
+	/* The NativeThunk of all the functions of type R(Args...) */
+	template<typename R, typename... Args>
+	int CallNativeThunk(NativePointer _native, Member* _result, const std::vector<Member*>& _args)
+	{
+		auto function = reinterpret_cast<R (*)(Args...)>(_native);
+		return CallNative(function, _result, _args, std::index_sequence_for<Args...>{});
+	}
+
+	template<typename R, typename... Args>
+	void Language::addToAPI(R (*_function)(Args...), const std::string& _identifier, bool _pure, const std::string& _label)
+	{
+		FunctionSignature signature(_identifier, NativeType<std::decay_t<R>>::tokenType, _label);
+		signature.pushArgs(NativeType<std::decay_t<Args>>::tokenType...);
+
+		Function function(signature, &CallNativeThunk<R, Args...>, reinterpret_cast<NativePointer>(_function));
+		function.pure = _pure;
+		addToAPI(function);
+	}
+}
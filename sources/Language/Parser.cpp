@@ -4,10 +4,13 @@
 #include "Container.h"
 #include "Variable.h"
 #include "Wire.h"
+#include "ComputeFunction.h"
 #include "Language.h"
 #include "Log.h"
-#include <regex>
 #include <algorithm>
+#include <unordered_map>
+#include <cstring>      // for memcpy
+#include <cstdlib>      // for strtod
 
 // Enable detailed logs
 // #define DEBUG_PARSER
@@ -20,8 +23,41 @@
 
 using namespace Nodable;
 
+/* Convert a number token to a double without allocating (token words are not null terminated) */
+static double parseNumber(std::string_view _word)
+{
+	char buffer[64];
+	if (_word.size() >= sizeof(buffer))
+		return std::stod(std::string(_word));
+
+	memcpy(buffer, _word.data(), _word.size());
+	buffer[_word.size()] = '\0';
+	return strtod(buffer, nullptr);
+}
+
+static size_t HashCombine(size_t _seed, size_t _value)
+{
+	return _seed ^ (_value + 0x9e3779b9 + (_seed << 6) + (_seed >> 2));
+}
+
+/* Disconnect the wire connected to an input member (if any) */
+static void DisconnectInput(Member* _input)
+{
+	if (_input->getInputMember() == nullptr)
+		return;
+
+	for (auto wire : _input->getOwner()->as<Node>()->getWires())
+	{
+		if (wire->getTarget() == _input)
+		{
+			Node::Disconnect(wire);
+			return;
+		}
+	}
+}
+
 Parser::Parser(const Language* _language, Container* _container):
-	                 language(_language), container(_container)
+	                 language(_language), container(_container), lexer(_language)
 {
 }
 
@@ -30,7 +66,7 @@ Parser::~Parser()
 
 }
 
-std::string Parser::logTokens(const std::vector<Token> _tokens, const size_t _highlight){
+std::string Parser::logTokens(const std::vector<Token>& _tokens, const size_t _highlight){
 	std::string result;
 
 	for (auto it = _tokens.begin(); it != _tokens.end(); it++ ) {
@@ -60,43 +96,109 @@ std::string Parser::logTokens(const std::vector<Token> _tokens, const size_t _hi
 
 bool Parser::eval(const std::string& _expression)
 {
-
-	if (!tokenizeExpressionString(_expression)) {
-		LOG_WARNING(0u, "Unable to parse expression due to unrecognysed tokens.\n");
+	Member* resultValue = nullptr;
+	size_t  cursor      = 0;
+
+	auto fail = [&](const char* _reason) {
+		if (resultValue != nullptr && resultValue->getOwner() == nullptr)
+			delete resultValue;
+		reusableNodes.clear();
+		previousVariables.clear();
+		LOG_WARNING(0u, "Unable to parse expression due to %s.\n", _reason);
 		return false;
-	}
+	};
 
-	if(tokens.size() == 0 )
-    {
-        LOG_MESSAGE(0u, "Nothing to evaluate.\n");
-        return false;
-    }
+	symbols.clear();
+	statementCount = 0;
 
-	if (!isSyntaxValid()) {
-		LOG_WARNING(0u, "Unable to parse expression due to syntax error.\n");
-		return false;
+	// the graph is evaluated only once complete
+	Container::Transaction transaction(container);
+
+	if (reconciliationEnabled)
+		collectReusableNodes();
+
+	// the whole expression at once, or a single statement per iteration when streaming
+	while (cursor < _expression.size())
+	{
+		const Cache::Entry* cached = cache != nullptr && !streamingEnabled ? cache->find(_expression) : nullptr;
+
+		if (cached != nullptr)
+		{
+			tokens     = cached->tokens;
+			ast        = cached->ast;
+			statements = cached->statements;
+			cursor     = _expression.size();
+		}
+		else
+		{
+			if (!tokenizeExpressionString(_expression, cursor))
+				return fail("unrecognysed tokens");
+
+			if (!isSyntaxValid())
+				return fail("syntax error");
+
+			if (!parseProgram())
+				return fail("abstract syntax tree failure");
+
+			if (cache != nullptr && !streamingEnabled)
+				cache->insert(_expression, tokens, ast, statements);
+		}
+
+		for (const auto& each : statements)
+		{
+			if (!validate(each))
+				return fail("unknown function or operator");
+		}
+
+		for (auto each : statements)
+		{
+			if (optimizationEnabled)
+				each.root = optimize(each);
+
+			// only the last statement's value is kept
+			if (resultValue != nullptr && resultValue->getOwner() == nullptr)
+				delete resultValue;
+
+			resultValue = lower(each);
+
+			if (auto symbol = findAssignedSymbol(each))
+				symbol->value = resultValue;
+		}
+
+		statementCount += statements.size();
 	}
 
-	Member* resultValue = parseRootExpression();
-	if (resultValue == nullptr) {
-		LOG_WARNING(0u, "Unable to parse expression due to abstract syntax tree failure.\n");
+	if (statementCount == 0)
+	{
+		LOG_MESSAGE(0u, "Nothing to evaluate.\n");
+		reusableNodes.clear();
+		previousVariables.clear();
 		return false;
 	}
 
-	Variable* result = container->newResult();
-	container->tryToRestoreResultNodePosition();
+	Variable* result = reconciliationEnabled ? container->getResultVariable() : nullptr;
+	if (result == nullptr)
+	{
+		result = container->newResult();
+		container->tryToRestoreResultNodePosition();
+	}
 
 	// If the value has no owner, we simply set the variable value
 	if (resultValue->getOwner() == nullptr)
 	{
+        DisconnectInput(result->getMember());
         result->set(resultValue);
         delete resultValue;
     }
-	else // we connect resultValue with resultVariable.value
+	else if (result->getMember()->getInputMember() != resultValue) // we connect resultValue with resultVariable.value
     {
+        DisconnectInput(result->getMember());
         Node::Connect(resultValue, result->getMember());
     }
 
+	if (reconciliationEnabled)
+		deleteUnusedNodes();
+
 	LOG_MESSAGE(0u, "Expression evaluated: %s\n", _expression.c_str() );
 	return true;
 }
@@ -123,7 +225,11 @@ Member* Parser::tokenToMember(const Token& _token) {
 			Variable* variable = context->findVariable(_token.word);
 
 			if (variable == nullptr)
-				variable = context->newVariable(_token.word);
+			{
+				// marked as built by a Parser, only those can be deleted once unused (cf. deleteUnusedNodes())
+				variable = context->newVariable(std::string(_token.word));
+				variable->setSourceHash(HashCombine((size_t)Ast::Kind::Variable, std::hash<std::string_view>{}(_token.word)));
+			}
 
 			NODABLE_ASSERT(variable != nullptr);
 			NODABLE_ASSERT(variable->getMember() != nullptr);
@@ -135,7 +241,7 @@ Member* Parser::tokenToMember(const Token& _token) {
 
 		case TokenType::Double: {
 			result = new Member(nullptr);
-			const double number = std::stod(_token.word);
+			const double number = parseNumber(_token.word);
 			result->set(number);
 			break;
 		}
@@ -151,309 +257,643 @@ Member* Parser::tokenToMember(const Token& _token) {
 	return result;
 }
 
-Member* Parser::parseBinaryOperationExpression(size_t& _tokenId, unsigned short _precedence, Member* _left) {
-
-	LOG_DEBUG_PARSER("parseBinaryOperationExpression...\n");
-	LOG_DEBUG_PARSER("%s \n", Parser::logTokens(tokens, _tokenId).c_str());
-
-	Member* result = nullptr;
+bool Parser::parseProgram()
+{
+	ast.clear();
+	statements.clear();
 
-	if (_tokenId + 1 >= tokens.size()) {
-		LOG_DEBUG_PARSER("parseBinaryOperationExpression... " KO " (not enought tokens)\n");
-		return nullptr;
-	}
+	size_t tokenId = 0;
 
-	const Token& token1(tokens.at(_tokenId));
-	const Token& token2(tokens.at(_tokenId+1));
+	while (tokenId < tokens.size())
+	{
+		// empty statement
+		if (tokens[tokenId].type == TokenType::EndOfInstruction)
+		{
+			tokenId++;
+			continue;
+		}
 
-	// Structure check
-	const bool isValid = _left != nullptr &&
-			             token1.type == TokenType::Operator &&
-			             token2.type != TokenType::Operator;
+		auto first = (Ast::Index)ast.size();
+		auto root  = parseExpression(tokenId);
 
-	if (!isValid) {
-		LOG_DEBUG_PARSER("parseBinaryOperationExpression... " KO " (Structure)\n");
-		return nullptr;
-	}
+		if (root == Ast::InvalidIndex)
+		{
+			LOG_DEBUG_PARSER("parse program " KO " (result == nullptr)\n");
+			return false;
+		}
 
-	// Precedence check
-	const auto currentOperatorPrecedence = language->findOperator(token1.word)->precedence;
+		// an expression must be followed by an end of instruction or by the end of the tokens
+		if (tokenId < tokens.size())
+		{
+			if (tokens[tokenId].type != TokenType::EndOfInstruction)
+			{
+				LOG_DEBUG_PARSER("parse program " KO " (unexpected token)\n");
+				LOG_DEBUG_PARSER("%s \n", Parser::logTokens(tokens, tokenId).c_str());
+				return false;
+			}
+			tokenId++;
+		}
 
-	if (currentOperatorPrecedence <= _precedence &&
-	    _precedence > 0u) { // always eval the first operation if they have the same precedence or less.
-		LOG_DEBUG_PARSER("parseBinaryOperationExpression... " KO " (Precedence)\n");
-		return nullptr;
+		statements.push_back({first, root});
 	}
 
+	return true;
+}
 
-	// Parse right expression
-	size_t rightTokenId = _tokenId + 1;
-	auto right = parseExpression(rightTokenId, currentOperatorPrecedence, nullptr );
+Ast::Index Parser::parseExpression(size_t& _tokenId)
+{
+	LOG_DEBUG_PARSER("parseExpression...\n");
+	LOG_DEBUG_PARSER("%s \n", Parser::logTokens(tokens, _tokenId).c_str());
 
-	if (!right) {
-		LOG_DEBUG_PARSER("parseBinaryOperationExpression... " KO " (right expression is nullptr)\n");
-		return nullptr;
-	}
+	using Kind = PendingOperation::Kind;
 
-	// Create a function signature according to ltype, rtype and operator word
-	auto signature        = language->createBinOperatorSignature(Type::Any, token1.word, _left->getType(), right->getType());
-	auto matchingOperator = language->findOperator(signature);
+	std::vector<Ast::Index>       operands;
+	std::vector<PendingOperation> operations;
+	size_t                        tokenId       = _tokenId;
+	bool                          expectOperand = true;
+	bool                          success       = true;
 
-	if ( matchingOperator != nullptr )
+	// Pop the operation on top of the stack and replace its operands by a new Ast node
+	auto reduce = [&]() -> bool
 	{
+		const auto   operation = operations.back();
+		const size_t count     = operands.size();
+		size_t       firstArg;
+		Ast::Kind    kind;
 
-		auto binOpNode = container->newBinOp( matchingOperator);
+		operations.pop_back();
 
-		// Connect the Left Operand :
-		//---------------------------
-		if (_left->getOwner() == nullptr)
+		switch (operation.kind)
 		{
-            binOpNode->set("lvalue", _left);
-            delete _left;
-        }
-		else
-        {
-			Node::Connect( _left, binOpNode->get("lvalue"));
-        }
+			case Kind::Binary:
+				if (count < 2)
+					return false;
+				firstArg = count - 2;
+				kind     = Ast::Kind::BinaryOperation;
+				break;
+
+			case Kind::Unary:
+				if (count < 1)
+					return false;
+				firstArg = count - 1;
+				kind     = Ast::Kind::UnaryOperation;
+				break;
+
+			case Kind::FunctionCall:
+				firstArg = operation.firstArg;
+				kind     = Ast::Kind::FunctionCall;
+				break;
+
+			default: // Parenthesis
+				return true;
+		}
 
-		// Connect the Right Operand :
+		auto node = ast.add(kind, operation.tokenId, operands.data() + firstArg, count - firstArg);
+		operands.resize(firstArg);
+		operands.push_back(node);
+		return true;
+	};
 
-		if (right->getOwner() == nullptr)
+	// Reduce binary operations on top of the stack while _condition is true
+	auto reduceBinaryOperations = [&](auto _condition) -> bool
+	{
+		while (!operations.empty() && operations.back().kind == Kind::Binary && _condition(operations.back()))
 		{
-            binOpNode->set("rvalue", right);
-            delete right;
-        }
-		else
-        {
-			Node::Connect(right, binOpNode->get("rvalue"));
-        }
+			if (!reduce())
+				return false;
+		}
+		return true;
+	};
 
-		// Set the left !
-		result = binOpNode->get("result");
+	// An operand has been pushed, apply the unary operators waiting for it
+	auto reduceUnaryOperations = [&]() -> bool
+	{
+		while (!operations.empty() && operations.back().kind == Kind::Unary)
+		{
+			if (!reduce())
+				return false;
+		}
+		return true;
+	};
 
-	}else {
-		LOG_DEBUG_PARSER("parseBinaryOperationExpression... " KO " (unable to find operator prototype)\n");
-		return nullptr;
+	auto always = [](const PendingOperation&) { return true; };
+
+	while (success && tokenId < tokens.size())
+	{
+		const Token& token = tokens[tokenId];
+		const Token* next  = tokenId + 1 < tokens.size() ? &tokens[tokenId + 1] : nullptr;
+
+		if (expectOperand)
+		{
+			if (token.type == TokenType::Operator)
+			{
+				operations.push_back({Kind::Unary, tokenId, 0});
+				tokenId++;
+			}
+			else if (token.type == TokenType::LBracket)
+			{
+				operations.push_back({Kind::Parenthesis, tokenId, 0});
+				tokenId++;
+			}
+			else if (token.type == TokenType::Symbol && next && next->type == TokenType::LBracket)
+			{
+				operations.push_back({Kind::FunctionCall, tokenId, operands.size()});
+				tokenId += 2;
+			}
+			else if (token.type == TokenType::Symbol && token.word == "operator" &&
+			         next && next->type == TokenType::Operator &&
+			         tokenId + 2 < tokens.size() && tokens[tokenId + 2].type == TokenType::LBracket)
+			{
+				operations.push_back({Kind::FunctionCall, tokenId, operands.size()});
+				tokenId += 3;
+			}
+			else if (token.type == TokenType::RBracket &&
+			         !operations.empty() && operations.back().kind == Kind::FunctionCall &&
+			         operations.back().firstArg == operands.size())
+			{
+				// function called without argument
+				success = reduce() && reduceUnaryOperations();
+				expectOperand = false;
+				tokenId++;
+			}
+			else if (token.type == TokenType::Symbol)
+			{
+				operands.push_back(ast.add(Ast::Kind::Variable, tokenId));
+				success = reduceUnaryOperations();
+				expectOperand = false;
+				tokenId++;
+			}
+			else if (token.type == TokenType::Double || token.type == TokenType::Boolean || token.type == TokenType::String)
+			{
+				operands.push_back(ast.add(Ast::Kind::Literal, tokenId));
+				success = reduceUnaryOperations();
+				expectOperand = false;
+				tokenId++;
+			}
+			else
+			{
+				LOG_DEBUG_PARSER("parseExpression... " KO " (operand expected)\n");
+				success = false;
+			}
+		}
+		else if (token.type == TokenType::Operator)
+		{
+			// operators with a precedence of 0 (ex: "=") are right associative, others are left associative.
+			success = reduceBinaryOperations([&](const PendingOperation& _top) {
+				auto topPrecedence = tokens[_top.tokenId].precedence;
+				return topPrecedence != 0u && token.precedence <= topPrecedence;
+			});
+			operations.push_back({Kind::Binary, tokenId, 0});
+			expectOperand = true;
+			tokenId++;
+		}
+		else if (token.type == TokenType::RBracket)
+		{
+			success = reduceBinaryOperations(always) && !operations.empty() && reduce() && reduceUnaryOperations();
+			tokenId++;
+		}
+		else if (token.type == TokenType::Separator)
+		{
+			success = reduceBinaryOperations(always) && !operations.empty() && operations.back().kind == Kind::FunctionCall;
+			expectOperand = true;
+			tokenId++;
+		}
+		else
+		{
+			break; // end of the expression
+		}
 	}
 
-	_tokenId = rightTokenId;
+	success = success && !expectOperand && reduceBinaryOperations(always) && operations.empty() && operands.size() == 1;
 
-	LOG_DEBUG_PARSER("parseBinaryOperationExpression... " OK "\n");
+	if (!success)
+	{
+		LOG_DEBUG_PARSER("parseExpression... " KO "\n");
+		return Ast::InvalidIndex;
+	}
 
-	return result;
+	LOG_DEBUG_PARSER("parseExpression... " OK "\n");
+	_tokenId = tokenId;
+	return operands.back();
 }
 
-Member* Parser::parseUnaryOperationExpression(size_t& _tokenId, unsigned short _precedence) {
+bool Parser::validate(const Statement& _statement)
+{
+	// children are always before their parent, types are known when a parent is reached.
+	for (Ast::Index i = _statement.first; i <= _statement.root; i++)
+	{
+		auto&        node     = ast.at(i);
+		const Token& token    = tokens[node.tokenId];
+		auto         children = ast.childrenOf(node);
 
-	LOG_DEBUG_PARSER("parseUnaryOperationExpression...\n");
-	LOG_DEBUG_PARSER("%s \n", Parser::logTokens(tokens, _tokenId).c_str());
+		switch (node.kind)
+		{
+			case Ast::Kind::Literal:
+			{
+				switch (token.type)
+				{
+					case TokenType::Boolean: node.type = Type::Boolean; break;
+					case TokenType::Double:  node.type = Type::Double;  break;
+					default:                 node.type = Type::String;  break;
+				}
+				break;
+			}
 
-	Member* result = nullptr;
+			case Ast::Kind::Variable:
+			{
+				auto symbol = symbols.find(token.word);
+				if (symbol != symbols.end())
+				{
+					node.type = symbol->second.type;
+				}
+				else
+				{
+					auto variable = container->findVariable(token.word);
+					node.type = variable ? variable->getMember()->getType() : Type::Any;
+				}
+				break;
+			}
 
-	const bool hasEnoughtTokens = tokens.size() > _tokenId + 1;
-	if (!hasEnoughtTokens)
-		return nullptr;
+			case Ast::Kind::BinaryOperation:
+			{
+				auto signature = language->createBinOperatorSignature(Type::Any, std::string(token.word), ast.at(children[0]).type, ast.at(children[1]).type);
+				node.function  = language->findOperator(signature);
+				break;
+			}
 
-	const Token& token1(tokens.at(_tokenId));
+			case Ast::Kind::UnaryOperation:
+			{
+				auto signature = language->createUnaryOperatorSignature(Type::Any, std::string(token.word), ast.at(children[0]).type);
+				node.function  = language->findOperator(signature);
+				break;
+			}
 
-	// Check if we get an operator first
-	if (token1.type != TokenType::Operator) {
-		LOG_DEBUG_PARSER("parseUnaryOperationExpression... " KO " (operator not found)\n");
-		return nullptr;
-	}
+			case Ast::Kind::FunctionCall:
+			{
+				// regular function (ex: "sin(...)") or function-like operator (ex: "operator+(...)")
+				std::string identifier(token.word);
+				if (tokens[node.tokenId + 1].type == TokenType::Operator)
+					identifier.append(tokens[node.tokenId + 1].word);
 
-	// Parse expression after the operator
-	auto valueTokenId = _tokenId + 1;
-	auto precedence = language->findOperator(token1.word)->precedence;
-	Member* value = nullptr;
+				FunctionSignature signature(identifier, TokenType::AnyType);
+				for (Ast::Index arg = 0; arg < node.childCount; arg++)
+					signature.pushArg(language->typeToTokenType(ast.at(children[arg]).type));
 
-	     if ( value = parseAtomicExpression(valueTokenId));
-	else if ( value = parseParenthesisExpression(valueTokenId));
-	else
-	{
-		LOG_DEBUG_PARSER("parseUnaryOperationExpression... " KO " (right expression is nullptr)\n");
-		return nullptr;
-	}
+				node.function = language->findFunction(signature);
+				break;
+			}
 
-	// Create a function signature
-	auto signature = language->createUnaryOperatorSignature(Type::Any, token1.word, value->getType() );
-	auto matchingOperator = language->findOperator(signature);
+			case Ast::Kind::Constant:
+				continue; // already resolved
+		}
 
-	if (matchingOperator != nullptr)
-	{
+		if (node.kind != Ast::Kind::Literal && node.kind != Ast::Kind::Variable)
+		{
+			if (node.function == nullptr)
+			{
+				LOG_DEBUG_PARSER("validate... " KO " (unable to find a prototype for %s)\n", std::string(token.word).c_str());
+				return false;
+			}
+			node.type = language->tokenTypeToType(node.function->signature.getType());
+		}
+	}
 
-		auto binOpNode = container->newUnaryOp(matchingOperator);
+	// next statements will read the assigned variable with this type
+	if (auto symbol = findAssignedSymbol(_statement))
+		symbol->type = ast.at(_statement.root).type;
 
-		// Connect the Left Operand :
-		//---------------------------
-		if (value->getOwner() == nullptr)
-		{
-            binOpNode->set("lvalue", value);
-            delete value;
-        }
-		else
-        {
-			Node::Connect(value, binOpNode->get("lvalue"));
-        }
+	return true;
+}
 
-		// Set the left !
-		result = binOpNode->get("result");
+Parser::Symbol* Parser::findAssignedSymbol(const Statement& _statement)
+{
+	const auto& root = ast.at(_statement.root);
 
-	} else {
-		LOG_DEBUG_PARSER("parseUnaryOperationExpression... " KO " (unrecognysed operator)\n");
+	if (root.kind != Ast::Kind::BinaryOperation || tokens[root.tokenId].word != "=")
 		return nullptr;
-	}
 
-	_tokenId = valueTokenId;
-	LOG_DEBUG_PARSER("parseUnaryOperationExpression... " OK "\n");
+	const auto& variable = ast.at(ast.childrenOf(root)[0]);
+	if (variable.kind != Ast::Kind::Variable)
+		return nullptr;
 
-	return result;
+	return &symbols[tokens[variable.tokenId].word];
 }
 
-Member* Parser::parseAtomicExpression(size_t& _tokenId) {
-
-	LOG_DEBUG_PARSER("parseAtomicExpression... \n");
+Member* Parser::newValue(Ast::Index _index)
+{
+	const auto& node = ast.at(_index);
 
-	// Check if there is index is not out of bounds
-	if (tokens.size() <= _tokenId) {
-		LOG_DEBUG_PARSER("parseAtomicExpression... " KO "(not enought tokens)\n");
-		return nullptr;
+	if (node.kind == Ast::Kind::Constant)
+	{
+		auto member = new Member(nullptr);
+		member->set(ast.getConstant(node));
+		return member;
 	}
 
-	auto token = tokens.at(_tokenId);
+	NODABLE_ASSERT(node.kind == Ast::Kind::Literal);
+	return tokenToMember(tokens[node.tokenId]);
+}
+
+Ast::Index Parser::optimize(const Statement& _statement)
+{
+	const Ast::Index first = _statement.first;
 
-	// Check if token is not an operator
-	if (token.type == TokenType::Operator) {
-		LOG_DEBUG_PARSER("parseAtomicExpression... " KO "(token is an operator)\n");
-		return nullptr;
-	}
+	auto isValue = [&](Ast::Index _index) {
+		auto kind = ast.at(_index).kind;
+		return kind == Ast::Kind::Literal || kind == Ast::Kind::Constant;
+	};
 
-	auto result = tokenToMember(token);
+	// hash of the structure of a node (its children must be canonical)
+	auto hashOf = [&](const Ast::Node& _node) -> size_t
+	{
+		size_t hash = HashCombine((size_t)_node.kind, (size_t)_node.function);
 
-	if( result != nullptr)
-		_tokenId++;
+		switch (_node.kind)
+		{
+			case Ast::Kind::Literal:
+			case Ast::Kind::Variable: return HashCombine(hash, std::hash<std::string_view>{}(tokens[_node.tokenId].word));
+			case Ast::Kind::Constant: return HashCombine(hash, std::hash<std::string>{}((std::string)ast.getConstant(_node)));
+			default:                  break;
+		}
 
-	LOG_DEBUG_PARSER("parseAtomicExpression... " OK "\n");
+		auto children = ast.childrenOf(_node);
+		for (Ast::Index i = 0; i < _node.childCount; i++)
+			hash = HashCombine(hash, children[i]);
+		return hash;
+	};
 
-	return result;
-}
+	auto isSame = [&](const Ast::Node& _a, const Ast::Node& _b) -> bool
+	{
+		if (_a.kind != _b.kind || _a.function != _b.function || _a.childCount != _b.childCount)
+			return false;
 
-Member* Parser::parseParenthesisExpression(size_t& _tokenId) {
+		switch (_a.kind)
+		{
+			case Ast::Kind::Literal:  return tokens[_a.tokenId].type == tokens[_b.tokenId].type &&
+			                                 tokens[_a.tokenId].word == tokens[_b.tokenId].word;
+			case Ast::Kind::Variable: return tokens[_a.tokenId].word == tokens[_b.tokenId].word;
+			case Ast::Kind::Constant: return ast.getConstant(_a) == ast.getConstant(_b);
+			default:                  return std::equal(ast.childrenOf(_a), ast.childrenOf(_a) + _a.childCount, ast.childrenOf(_b));
+		}
+	};
 
-	LOG_DEBUG_PARSER("parseParenthesisExpression...");
-	LOG_DEBUG_PARSER("%s \n", Parser::logTokens(tokens, _tokenId).c_str());
+	// indexed from the statement's first node
+	std::vector<Ast::Index>                              canonical(_statement.root - first + 1);
+	std::unordered_map<size_t, std::vector<Ast::Index>> nodesByHash;
+	std::vector<Member*>                                 args;
 
-	if (_tokenId >= tokens.size())
-		return nullptr;
+	// children are always before their parent, they are already optimized when a parent is reached.
+	for (Ast::Index i = first; i <= _statement.root; i++)
+	{
+		auto& node     = ast.at(i);
+		auto  children = ast.childrenOf(node);
+		bool  foldable = node.function != nullptr && node.function->pure;
 
-	auto token1(tokens.at(_tokenId));
+		for (Ast::Index c = 0; c < node.childCount; c++)
+		{
+			children[c] = canonical[children[c] - first];
+			foldable &= isValue(children[c]);
+		}
 
-	if (token1.type != TokenType::LBracket) {
-		return nullptr;
-	}
+		// Constant folding: evaluate the function now
+		if (foldable)
+		{
+			args.clear();
+			for (Ast::Index c = 0; c < node.childCount; c++)
+				args.push_back(newValue(children[c]));
 
-	Member* result(nullptr);
+			Member result(nullptr);
+			result.setType(node.type);
 
-	if (token1.word == "(") {
+			if (node.function->call(&result, args) == 0)
+				ast.setConstant(i, result.getData());
 
-		auto subToken = _tokenId + 1;
-		result = parseExpression(subToken, 0u, nullptr);
+			for (auto each : args)
+				delete each;
+		}
 
-		if (result)
+		// Common subexpression elimination: use the first identical node (impure ones are kept)
+		canonical[i - first] = i;
+		if (node.function == nullptr || node.function->pure)
 		{
-			_tokenId = subToken + 1;
-
-			if (tokens.at(subToken).word != ")") {
-				LOG_DEBUG_PARSER("%s \n", Parser::logTokens(tokens, _tokenId).c_str());
-				LOG_DEBUG_PARSER("parseParenthesisExpression failed... " KO " ( \")\" expected after %s )\n", tokens.at(subToken - 1));
-			}
-			else {
-				LOG_DEBUG_PARSER("parseParenthesisExpression... " OK  "\n");
-			}
+			auto& candidates = nodesByHash[hashOf(node)];
+			auto  found      = std::find_if(candidates.begin(), candidates.end(), [&](Ast::Index _other) {
+				return isSame(ast.at(_other), node);
+			});
+
+			if (found != candidates.end())
+				canonical[i - first] = *found;
+			else
+				candidates.push_back(i);
 		}
-	} else {
-		LOG_DEBUG_PARSER("parseParenthesisExpression... " KO " (open parenthesis not found) \n");
 	}
 
-
-	return result;
+	return canonical[_statement.root - first];
 }
 
-Member* Parser::parseRootExpression() {
+Member* Parser::lower(const Statement& _statement)
+{
+	// vectors are indexed from the statement's first node
+	const Ast::Index first = _statement.first;
+	const Ast::Index root  = _statement.root;
 
-	size_t  tokenId      = 0;
-	Member* result       = nullptr;
-	bool    parsingError = false;
+	// a node is converted only if used by the root (optimizations may leave unused nodes)
+	std::vector<bool> used(root - first + 1, false);
+	used[root - first] = true;
 
-	result = parseExpression(tokenId, 0u, result);
+	for (Ast::Index i = root + 1; i-- > first;)
+	{
+		if (!used[i - first])
+			continue;
 
-	const auto tokenLeft = tokens.size() - tokenId;
-	if (tokenLeft != 0) {   // Check if all tokens have been consumed
-		LOG_DEBUG_PARSER("parse root expression " KO " (not tokens not all consumed)");
+		const auto& node     = ast.at(i);
+		auto        children = ast.childrenOf(node);
+		for (Ast::Index c = 0; c < node.childCount; c++)
+			used[children[c] - first] = true;
 	}
 
-	if (result == nullptr) { // Check if result is defined
-		LOG_DEBUG_PARSER("parse root expression " KO " (result == nullptr)\n");
-	}
+	// values (literals and constants) are created for each use, since they are copied then deleted (cf. connectOperand())
+	std::vector<Member*> members(root - first + 1, nullptr);
+	std::vector<size_t>  hashes(root - first + 1, 0);
+	auto operand = [&](Ast::Index _index) -> Member* {
+		auto kind = ast.at(_index).kind;
+		return kind == Ast::Kind::Literal || kind == Ast::Kind::Constant ? newValue(_index) : members[_index - first];
+	};
 
-	LOG_DEBUG_PARSER("%s \n", Parser::logTokens(tokens, tokenId).c_str());
+	for (Ast::Index i = first; i <= root; i++)
+	{
+		if (!used[i - first])
+			continue;
+
+		const auto&  node     = ast.at(i);
+		const Token& token    = tokens[node.tokenId];
+		auto         children = ast.childrenOf(node);
+		auto&        member   = members[i - first];
+		auto&        hash     = hashes[i - first];
+
+		// structural hash of the subexpression, a node built from the same one in a previous eval() is reused
+		hash = HashCombine((size_t)node.kind, (size_t)node.function);
+		switch (node.kind)
+		{
+			case Ast::Kind::Literal:  hash = HashCombine(HashCombine(hash, (size_t)token.type), std::hash<std::string_view>{}(token.word)); break;
+			case Ast::Kind::Variable: hash = HashCombine(hash, std::hash<std::string_view>{}(token.word)); break;
+			case Ast::Kind::Constant: hash = HashCombine(hash, std::hash<std::string>{}((std::string)ast.getConstant(node))); break;
+			default:
+				for (Ast::Index c = 0; c < node.childCount; c++)
+					hash = HashCombine(hash, hashes[children[c] - first]);
+		}
 
-	return result;
-}
+		auto reuseOrCreate = [&](auto _create) -> Node* {
+			Node* result = reuseNode(hash, node.function);
+			if (result == nullptr)
+			{
+				result = _create();
+				result->setSourceHash(hash);
+			}
+			return result;
+		};
 
-Member* Parser::parseExpression(size_t& _tokenId, unsigned short _precedence, Member* _leftOverride) {
+		switch (node.kind)
+		{
+			case Ast::Kind::Literal:
+			case Ast::Kind::Constant:
+			{
+				if (i == root)
+					member = newValue(i);
+				break;
+			}
 
-	LOG_DEBUG_PARSER("parseExpression...\n");
-	LOG_DEBUG_PARSER("%s \n", Parser::logTokens(tokens, _tokenId).c_str());
+			case Ast::Kind::Variable:
+			{
+				// a variable assigned by a previous statement is read from its assignment
+				auto symbol = symbols.find(token.word);
+				if (symbol != symbols.end() && symbol->second.value != nullptr)
+					member = symbol->second.value;
+				else
+					member = tokenToMember(token);
+				break;
+			}
 
-	if (_tokenId >= tokens.size()) {
-		LOG_DEBUG_PARSER("parseExpression..." KO " (last token)\n");
-	}
+			case Ast::Kind::BinaryOperation:
+			{
+				auto binOpNode = reuseOrCreate([&] { return container->newBinOp(static_cast<const Operator*>(node.function)); });
+				connectOperand(operand(children[0]), binOpNode->get("lvalue"));
+				connectOperand(operand(children[1]), binOpNode->get("rvalue"));
+				member = binOpNode->get("result");
+				break;
+			}
 
-	/**
-		Get the left handed operand
-	*/
-	Member* left = nullptr;
+			case Ast::Kind::UnaryOperation:
+			{
+				auto unaryOpNode = reuseOrCreate([&] { return container->newUnaryOp(static_cast<const Operator*>(node.function)); });
+				connectOperand(operand(children[0]), unaryOpNode->get("lvalue"));
+				member = unaryOpNode->get("result");
+				break;
+			}
 
-	if (left = _leftOverride);
-	else if (left = parseParenthesisExpression(_tokenId));
-	else if (left = parseUnaryOperationExpression(_tokenId, _precedence));
-	else if (left = parseFunctionCall(_tokenId));
-	else if (left = parseAtomicExpression(_tokenId))
+			case Ast::Kind::FunctionCall:
+			{
+				auto  functionNode = reuseOrCreate([&] { return container->newFunction(node.function); });
+				auto& args         = node.function->signature.getArgs();
 
-	if (_tokenId >= tokens.size()) {
-		LOG_DEBUG_PARSER("parseExpression..." OK " (parsing only left, last token)\n");
-		return left;
-	}
+				for (size_t arg = 0; arg < args.size(); arg++)
+					connectOperand(operand(children[arg]), functionNode->get(args[arg].name.c_str()));
 
-	Member* result;
+				member = functionNode->get("result");
+				break;
+			}
+		}
+	}
 
-	/**
-		Get the right handed operand
-	*/
+	return members[root - first];
+}
 
-	if (left != nullptr) {
+void Parser::connectOperand(Member* _value, Member* _input)
+{
+	if (_value->getOwner() == nullptr)
+	{
+		// a reused node keeps its value (and does not need to be evaluated again)
+		if (_input->getInputMember() != nullptr || _input->getData() != _value->getData())
+		{
+			DisconnectInput(_input);
+			_input->set(_value);
+		}
+		delete _value;
+	}
+	else if (_input->getInputMember() != _value)
+	{
+		DisconnectInput(_input);
+		Node::Connect(_value, _input);
+	}
+}
 
-		LOG_DEBUG_PARSER("left parsed, we parse right\n");
-		auto binResult = parseBinaryOperationExpression(_tokenId, _precedence, left);
+void Parser::collectReusableNodes()
+{
+	reusableNodes.clear();
 
-		if (binResult) {
-			LOG_DEBUG_PARSER("right parsed, recursive call\n");
-			result = parseExpression(_tokenId, _precedence, binResult);
-		}
-		else {
-			result = left;
-		}
+	// in creation order, identical subexpressions are then matched in the same order as before
+	for (auto each : container->getEntities())
+	{
+		if (each->getSourceHash() != 0 && dynamic_cast<Variable*>(each) == nullptr)
+			reusableNodes[each->getSourceHash()].push_back(each);
+	}
 
-	} else {
-		LOG_DEBUG_PARSER("left is nullptr, we return it\n");
-		result = left;
+	// variables are reused by name, only the ones built from a symbol are candidates for deletion
+	// (the ones created by the user, ex: from the ContainerView menu, are left untouched)
+	previousVariables.clear();
+	for (auto each : container->getVariables())
+	{
+		if (each->getSourceHash() != 0)
+			previousVariables.push_back(each);
 	}
+}
 
-	return result;
+Node* Parser::reuseNode(size_t _sourceHash, const Function* _function)
+{
+	auto found = reusableNodes.find(_sourceHash);
+	if (found == reusableNodes.end())
+		return nullptr;
+
+	// hashes can collide, a node computing another function (or operator) would not have the same members
+	auto& candidates = found->second;
+	auto  candidate  = std::find_if(candidates.begin(), candidates.end(), [&](Node* _node) {
+		auto compute = _node->getComponent<ComputeFunction>();
+		return compute != nullptr && compute->getFunction() == _function;
+	});
+	if (candidate == candidates.end())
+		return nullptr;
+
+	auto node = *candidate;
+	candidates.erase(candidate);
+	if (candidates.empty())
+		reusableNodes.erase(found);
+
+	return node;
 }
 
+void Parser::deleteUnusedNodes()
+{
+	for (const auto& pair : reusableNodes)
+	{
+		for (auto each : pair.second)
+		{
+			container->remove(each);
+			Arena::Delete(each);
+		}
+	}
+	reusableNodes.clear();
 
+	// variables built by a previous eval() (cf. tokenToMember()) that are no longer read or written are disconnected now
+	for (auto each : previousVariables)
+	{
+		if (each != container->getResultVariable() && each->getWires().empty())
+		{
+			container->remove(each);
+			Arena::Delete(each);
+		}
+	}
+	previousVariables.clear();
+}
 
 bool Parser::isSyntaxValid()
 {
@@ -463,7 +903,7 @@ bool Parser::isSyntaxValid()
 
 	while( it != tokens.end() && success == true) {
 
-		auto current = *it;
+		const Token& current = *it;
 		const bool isLastToken = tokens.end() - it == 1;
 
 		switch (current.type)
@@ -476,7 +916,7 @@ bool Parser::isSyntaxValid()
 				success = false; // Last token can't be an operator
 
 			} else {
-				auto next = *(it + 1);
+				const Token& next = *(it + 1);
 				if (next.type == TokenType::Operator)
 					success = false; // An operator can't be followed by another operator.
 			}
@@ -504,11 +944,11 @@ bool Parser::isSyntaxValid()
 		}
 
 		if (!isLastToken && current.isOperand()) { // Avoid an operand to be followed by another operand.
-			auto next = *(it + 1);
+			const Token& next = *(it + 1);
 			auto isAnOperand = next.isOperand();
 
 			if (isAnOperand) {
-				LOG_DEBUG_PARSER("Unable to tokenize expression, %s unexpected after %s \n", current.word.c_str(), next.word.c_str());
+				LOG_DEBUG_PARSER("Unable to tokenize expression, %s unexpected after %s \n", std::string(current.word).c_str(), std::string(next.word).c_str());
 				success = false;
 			}
 		}
@@ -524,173 +964,60 @@ bool Parser::isSyntaxValid()
 	return success;
 }
 
-bool Parser::tokenizeExpressionString(const std::string& _expression)
+bool Parser::tokenizeExpressionString(const std::string& _expression, size_t& _cursor)
 {
+	tokens.clear();
 
-	/* get expression chars */
-	auto chars = _expression;
-
-	/* shortcuts to language members */
-	auto regex    = language->dictionnary.getTokenTypeToRegexMap();
-
-	for(auto it = chars.cbegin(); it != chars.cend(); ++it)
-	{
-		std::string currStr    = chars.substr(it - chars.cbegin(), 1);
-		auto        currDist   = std::distance(chars.cbegin(), it);
-
-		// Unified parsing (loop over all regex)
-		auto unifiedParsing = [&]() -> auto {
-			for (auto pair_it = regex.cbegin(); pair_it != regex.cend(); pair_it++)
-			{
-				std::smatch sm;
-				auto match = std::regex_search(it, chars.cend(), sm, pair_it->second);
-
-				if (match) {
-					auto str   = sm.str(0);
-					auto token = pair_it->first;
-
-					if (token != TokenType::Ignore)
-					{
-						if (token == TokenType::String)
-							addToken(token, std::string(++str.cbegin(), --str.cend()), std::distance(chars.cbegin(), it));
-						else
-							addToken(token, str, std::distance(chars.cbegin(), it));
-					}
-
-					// advance iterator to the end of the str
-					for (size_t i = 0; i < str.length() - 1; i++) it++;
-
-					return true;
-				}
-			}
-			return false;
-		};
-
-		if (!unifiedParsing())
-		{
-			return false;
-		}
-	}
-
-	return true;
+	if (streamingEnabled)
+		return lexer.tokenizeStatement(_expression, _cursor, tokens);
 
+	_cursor = _expression.size();
+	return lexer.tokenize(_expression, tokens);
 }
 
-void Parser::addToken(TokenType  _type, std::string _string, size_t _charIndex)
+void Parser::Cache::clear()
 {
-	Token t;
-	t.type      = _type;
-	t.word      = _string;
-	t.charIndex = _charIndex;
-
-	tokens.push_back(t);
+	entriesByCode.clear();
+	entries.clear();
+	hits   = 0;
+	misses = 0;
 }
 
-Member* Parser::parseFunctionCall(size_t& _tokenId)
+const Parser::Cache::Entry* Parser::Cache::find(const std::string& _code)
 {
-	size_t localTokenId = _tokenId;
-
-	std::string identifier;
-
-	// Check if the minimum token count required is available ( 0: identifier, 1: open parenthesis, 2: close parenthesis)
-	if (localTokenId + 2 >= tokens.size() )
+	auto found = entriesByCode.find(_code);
+	if (found == entriesByCode.end())
 	{
-		LOG_DEBUG_PARSER("parseFunctionCall aborted. Not enough tokens.");
+		misses++;
 		return nullptr;
 	}
 
+	hits++;
+	entries.splice(entries.begin(), entries, found->second);
+	return &entries.front();
+}
 
-	const auto token_0 = tokens.at(localTokenId);
-	const auto token_1 = tokens.at(localTokenId + 1);
-	const auto token_2 = tokens.at(localTokenId + 2);
-
-	// regular function
-	if (token_0.type == TokenType::Symbol &&
-		token_1.type == TokenType::LBracket)
-	{
-		identifier = token_0.word;
-		localTokenId++;
-	}
+void Parser::Cache::insert(const std::string& _code, const std::vector<Token>& _tokens, const Ast& _ast, const std::vector<Statement>& _statements)
+{
+	if (capacity == 0 || entriesByCode.count(_code) != 0)
+		return;
 
-	// operator like (ex: operator==(..,..))
-	else if (token_0.type == TokenType::Symbol &&
-		     token_1.type == TokenType::Operator &&
-		     token_2.type == TokenType::LBracket)
+	if (entries.size() == capacity)
 	{
-                // ex: "operator" + ">="
-		identifier = token_0.word + token_1.word;
-		localTokenId += 2;
+		entriesByCode.erase(entries.back().code);
+		entries.pop_back();
 	}
-	else
-	{
-		LOG_DEBUG_PARSER("parseFunctionCall aborted. (no regular function or function-like operator found)");
-		return nullptr;
-	}
-
-	std::vector<Member*> args;
-
-	// Declare a new function prototype
-	FunctionSignature signature(identifier, TokenType::AnyType);
 
-	localTokenId++; // eat parenthesis
+	entries.emplace_front();
+	auto& entry      = entries.front();
+	entry.code       = _code;
+	entry.tokens     = _tokens;
+	entry.ast        = _ast;
+	entry.statements = _statements;
 
-	bool parsingError = false;
-	while ( !parsingError &&
-		     localTokenId < tokens.size() &&
-		     tokens.at(localTokenId).type != TokenType::RBracket)
-	{
-
-		if (auto member = parseExpression(localTokenId))
-		{
-			args.push_back(member); // store argument as member (already parsed)
-			signature.pushArg( language->typeToTokenType(member->getType()) );  // add a new argument type to the proto.
-
-			if (tokens.at(localTokenId).type == TokenType::Separator)
-				localTokenId++;
-
-		}
-		else
-		{
-			parsingError = true;
-		}
-	}
-
-
-	if (tokens.at(localTokenId).type != TokenType::RBracket ) {
-		LOG_DEBUG_PARSER("parseFunctionCall aborted. Close parenthesis expected !");
-		return nullptr;
-	}
-
-	localTokenId++; // eat parenthesis
-
-	// Find the prototype in the language library
-	auto fct = language->findFunction(signature);
-
-	if( fct != nullptr) { // if function found
-
-		auto node = container->newFunction(fct);
-
-		auto connectArg = [&](size_t _argIndex)-> void { // lambda to connect input member to node for a specific argument index.
-
-			auto arg = args.at(_argIndex);
-			auto memberName = fct->signature.getArgs().at(_argIndex).name;
-
-			if (arg->getOwner() == nullptr) {
-				node->set(memberName.c_str(), arg);
-			} else {
-				Node::Connect(arg, node->get(memberName.c_str()));
-			}
-		};
-
-		for( size_t argIndex = 0; argIndex < fct->signature.getArgs().size(); argIndex++ )
-			connectArg(argIndex);
-
-		_tokenId = localTokenId;
-		return node->get("result");
-
-	} else {
-		LOG_DEBUG_PARSER("Unable to parse function, prototype not found.");
-	}
+	// token words must be views into the cached code
+	for (auto& token : entry.tokens)
+		token.word = std::string_view(entry.code.data() + (token.word.data() - _code.data()), token.word.size());
 
-	return nullptr;
+	entriesByCode.emplace(entry.code, entries.begin());
 }
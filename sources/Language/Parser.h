@@ -1,10 +1,15 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <string_view>
+#include <unordered_map>
+#include <list>
 
 #include "Nodable.h"    // forward declarations
 #include "Language.h"
 #include "Token.h"
+#include "Lexer.h"
+#include "Ast.h"
 
 namespace Nodable{
 
@@ -13,12 +18,18 @@ namespace Nodable{
 		The role of this class is to convert code string to a Nodable graph.
 
 		The main strategy is:
-		- cut string into tokens
-		(TODO: before converting to Nodable graph, we need to build an AST)
-		- parse token list to convert it to Nodable graph.
+		- cut string into tokens (cf. Lexer)
+		- parse token list to build an Abstract Syntax Tree (cf. Ast), one per statement
+		- validate the trees (resolve types, operators and functions)
+		- optionally optimize the trees (cf. setOptimizationEnabled())
+		- lower the trees to a Nodable graph (only once all trees are valid).
 
 		ex: "a+b" will became an Add node connected to two Variable* a and b.
 
+		A program is a list of statements separated by ";" (ex: "a = 5; b = a * 2; b + 1").
+		A variable assigned by a statement is read from this assignment by the next statements,
+		and the last statement is connected to the container's result.
+
 		*:Variable is a Node extended class
 	*/
 
@@ -32,54 +43,129 @@ namespace Nodable{
 		Parser(const Language* _language, Container* _container);
 		~Parser();
 
-		/* Evaluates an expression as a string.
+		/* Evaluates a program (one or more statements) as a string.
 		   Return true if evaluation went well and false otherwise. */
 		bool eval(const std::string& );
 
-	private:
-		/* Convert a Token to a Member*/
-		Member* tokenToMember(const Token& _token);
-
-		/* Parse the root expression.
-		   The root expression is set when calling eval().
-		   Return the result as a Member or nullptr if parsing failed. */
-		Member* parseRootExpression();
+		/* When enabled, constant subtrees are computed while parsing (ex: "2*(5+3)" becomes "16")
+		   and identical pure subtrees are built only once (ex: "(a+1)*(a+1)" has a single "a+1" node).
+		   Disabled by default: the graph then mirrors the source text. */
+		void setOptimizationEnabled(bool _enabled) { optimizationEnabled = _enabled; }
+		bool isOptimizationEnabled()const { return optimizationEnabled; }
 
-		/* Parse a Function call starting at a specific token index.
-		   Return the result as a Member or nullptr if parsing failed. */
-		Member* parseFunctionCall(size_t& _tokenId);
+		/* When enabled, statements are tokenized, parsed and converted to the graph one after the other,
+		   so the memory used by tokens and trees does not depend on the program size.
+		   Statements before a wrong one are then kept in the container.
+		   Disabled by default: a wrong program builds nothing. */
+		void setStreamingEnabled(bool _enabled) { streamingEnabled = _enabled; }
+		bool isStreamingEnabled()const { return streamingEnabled; }
 
-		/* Parse a sub expression starting at a specific token index.
-		   A sub expression is like: "( expression )"
-		   Return the result as Member or nullptr if parsing failed. */
-		Member* parseParenthesisExpression(size_t& _tokenId);
+		/* When enabled, eval() updates the graph built by a previous eval() in the same container instead of adding a new one:
+		   nodes built from an unchanged subexpression are kept (with their views and values), only the changed ones are rebuilt
+		   and the previous nodes no longer used are deleted. A wrong expression leaves the graph untouched.
+		   Disabled by default. */
+		void setReconciliationEnabled(bool _enabled) { reconciliationEnabled = _enabled; }
+		bool isReconciliationEnabled()const { return reconciliationEnabled; }
 
-		/* Parse binary operation expression starting at a specific token index.
-		   _precedence is the precedence value of the previous operator.
-		   _left is the left handed side of the operation.
-		*/
-		Member* parseBinaryOperationExpression(size_t& _tokenId, unsigned short _precedence = 0u, Member* _left = nullptr);
+		class Cache;
 
-		/** To parse two tokens (ex: !true, -5, etc..) */
-		Member* parseUnaryOperationExpression(size_t& _tokenId, unsigned short _precedence = 0u);
+		/* Read programs from a cache of already parsed ones (cf. Parser::Cache) and store new ones into it.
+		   nullptr to disable (default). The cache is not used when streaming is enabled. */
+		void setCache(Cache* _cache) { cache = _cache; }
 
-		/** To parse a primary expression (ex: "myVariable", "10.4", etc... ) */
-		Member* parseAtomicExpression(size_t& _tokenId);
+		/* Return the number of statements read by the last eval() */
+		size_t getStatementCount()const { return statementCount; }
 
-		/* Build a graph resursively starting at the token _tokenIndex reading up to _tokenIdMax tokens.*/
-		Member* parseExpression(size_t& _tokenIndex, unsigned short _precedence = 0u, Member* _left = nullptr);
+	private:
+		/* Convert a literal or a symbol Token to a Member (a symbol gets or creates a Variable) */
+		Member* tokenToMember(const Token& _token);
 
-		/* Cut the member "expression" into tokens to identifies its type (cf. TokenType enum) */
-		bool tokenizeExpressionString(const std::string& _expression);
+		/* A statement is a range of Ast nodes, its root node is the last one */
+		struct Statement
+		{
+			Ast::Index first;
+			Ast::Index root;
+		};
+
+		/* A variable assigned by a previous statement (ex: "a" in "a = 5;") */
+		struct Symbol
+		{
+			Type    type  = Type::Any;
+			Member* value = nullptr;   // the assignment result, set once the statement is lowered
+		};
+
+		/* Parse all the statements of the current tokens (ex: "a = 5; a + 1").
+		   Each statement is an expression followed by an end of instruction or by the end of the tokens.
+		   Return false if parsing failed. */
+		bool parseProgram();
+
+		/* Parse an expression starting at a specific token index, without any recursion:
+		   operands and pending operations (operators, parenthesis, function calls) are stored on two stacks,
+		   operations are reduced following the operators precedence (cf. Token::precedence).
+		   Parsing stops at the first token that can't continue the expression (ex: ";").
+		   Return the index of the expression node in the Ast or Ast::InvalidIndex if parsing failed. */
+		Ast::Index parseExpression(size_t& _tokenId);
+
+		/* Resolve the type of each statement's node, and the operator or function of each operation.
+		   Return false if an operator or a function is unknown. Nothing is created in the container. */
+		bool validate(const Statement& _statement);
+
+		/* Fold constant subtrees of a (validated) statement and merge identical pure subtrees.
+		   Operations that can't be evaluated ahead of time (impure or failing functions) are kept.
+		   Return the new root index. */
+		Ast::Index optimize(const Statement& _statement);
+
+		/* Create a Member without owner with the value of a Literal or Constant Ast node */
+		Member* newValue(Ast::Index _index);
+
+		/* Convert a (validated) statement to Nodes and Wires into the container.
+		   Only the nodes reachable from its root are converted.
+		   Return the Member corresponding to the root node. */
+		Member* lower(const Statement& _statement);
+
+		/* Return the symbol assigned by a statement (ex: "a" for "a = b + 1"), nullptr if none */
+		Symbol* findAssignedSymbol(const Statement& _statement);
+
+		/* Copy _value into _input if _value has no owner (and delete it), connect them otherwise.
+		   An input already connected to _value (or having the same value) is left untouched. */
+		void connectOperand(Member* _value, Member* _input);
+
+		/* Index the container's nodes built by a previous eval() by source hash (cf. Node::getSourceHash()) */
+		void collectReusableNodes();
+
+		/* Return a node built by a previous eval() from an identical subexpression (same hash, computing _function)
+		   and remove it from the reusable nodes. Return nullptr if none. */
+		Node* reuseNode(size_t _sourceHash, const Function* _function);
+
+		/* Delete the nodes built by a previous eval() that have not been reused, and the variables it built that are no longer connected */
+		void deleteUnusedNodes();
+
+		/* An operation waiting for its operands on the parseExpression() stack */
+		struct PendingOperation
+		{
+			enum class Kind
+			{
+				Binary,
+				Unary,
+				Parenthesis,
+				FunctionCall
+			};
+
+			Kind   kind;
+			size_t tokenId;   // operator, open parenthesis or function identifier token
+			size_t firstArg;  // FunctionCall only, index of the first argument in the operand stack
+		};
+
+		/* Cut the expression (from _cursor) into tokens to identifies its type (cf. TokenType enum).
+		   Read a single statement when streaming is enabled, the whole expression otherwise.
+		   _cursor is moved after the last char read. */
+		bool tokenizeExpressionString(const std::string& _expression, size_t& _cursor);
 
 		/* Check if the existing tokens match with the syntax of the language. tokenize() should be called first */
 		bool isSyntaxValid();
 
 		/** Generate a string with all tokens with _tokens[_highlight] colored in green*/
-		std::string logTokens(const std::vector<Token> _tokens, const size_t _highlight);
-
-		/* Adds a new token given a _type, _string and _charIndex and add it to the tokens.*/
-		void addToken(TokenType _type, std::string _string, size_t _charIndex);
+		std::string logTokens(const std::vector<Token>& _tokens, const size_t _highlight);
 
 		/* To store the result of the tokenizeExpressionString() method
 		   contain a vector of Tokens to be converted to a Nodable graph by all parseXXX functions */
@@ -90,6 +176,69 @@ namespace Nodable{
 
 		/* The target container of the parser in which all generated nodes will be pushed into*/
 		Container* container;
+
+		/* Cut the expression string into tokens, built once from the language */
+		Lexer lexer;
+
+		/* The trees built from tokens by parseProgram(), one per statement */
+		Ast                    ast;
+		std::vector<Statement> statements;
+
+		/* Variables assigned by the statements already read, by name (views into the evaluated code) */
+		std::unordered_map<std::string_view, Symbol> symbols;
+
+		/* Nodes built by a previous eval(), by source hash, and the variables it built (reconciliation only) */
+		std::unordered_map<size_t, std::vector<Node*>> reusableNodes;
+		std::vector<Variable*>                         previousVariables;
+
+		Cache* cache                 = nullptr;
+		size_t statementCount        = 0;
+		bool   optimizationEnabled   = false;
+		bool   streamingEnabled      = false;
+		bool   reconciliationEnabled = false;
+	};
+
+	/*
+		The role of this class is to remember the last parsed programs (tokens and Ast, before validation) by source code.
+
+		A Parser using a Cache (cf. Parser::setCache()) skips tokenization and parsing when evaluating a code it already parsed
+		(ex: undo/redo or selection changes in a File). Types, operators and functions are always validated again,
+		since they depend on the variables of the container.
+		The least recently used program is dropped when the capacity is reached.
+	*/
+	class Parser::Cache
+	{
+	public:
+		explicit Cache(size_t _capacity = 32): capacity(_capacity) {}
+		~Cache() = default;
+
+		size_t getHits()const { return hits; }
+		size_t getMisses()const { return misses; }
+		size_t size()const { return entries.size(); }
+		void   clear();
+
+	private:
+		friend class Parser;
+
+		struct Entry
+		{
+			std::string            code;
+			std::vector<Token>     tokens;     // words are views into code
+			Ast                    ast;
+			std::vector<Statement> statements;
+		};
+
+		/* Return the entry parsed from _code (and make it the most recently used one), nullptr if none */
+		const Entry* find(const std::string& _code);
+
+		/* Store a program parsed from _code, token words are views into _code */
+		void insert(const std::string& _code, const std::vector<Token>& _tokens, const Ast& _ast, const std::vector<Statement>& _statements);
+
+		size_t           capacity;
+		size_t           hits   = 0;
+		size_t           misses = 0;
+		std::list<Entry> entries;  // most recently used first
+		std::unordered_map<std::string_view, std::list<Entry>::iterator> entriesByCode; // keys are views into Entry::code
 	};
 
 }
\ No newline at end of file
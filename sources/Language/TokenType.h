@@ -34,6 +34,11 @@ namespace Nodable {
         StringType,
         DoubleType,
         BooleanType,
+        Int64Type,
+        Float32Type,
+        Vec2Type,
+        Vec3Type,
+        Vec4Type,
 
 		Default = Unknown
 
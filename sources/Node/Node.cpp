@@ -8,7 +8,8 @@
 #include "History.h"
 #include "DataAccess.h"
 #include "ComputeBase.h"
-#include "NodeTraversal.h"
+#include "Container.h"
+#include "Arena.h"
 
 using namespace Nodable;
 
@@ -22,9 +23,9 @@ void Node::Disconnect(Wire* _wire)
 	targetNode->removeWire(_wire);
 	sourceNode->removeWire(_wire);
 
-	NodeTraversal::SetDirty(targetNode);
+	targetNode->flagAsDirty();
 
-    delete _wire;
+    Arena::Delete(_wire);
 
 	return;
 }
@@ -55,12 +56,13 @@ Wire* Node::Connect( Member* _from, Member* _to)
     targetNode->addWire(wire);
     sourceNode->addWire(wire);
 
-    NodeTraversal::SetDirty(targetNode);
+    targetNode->flagAsDirty();
 
     return wire;
 }
 
-Node::Node(std::string _label):
+Node::Node(std::string _label, Arena* _arena):
+	Object(_arena),
 
 	parentContainer(nullptr),
 	label(_label),
@@ -71,19 +73,41 @@ Node::Node(std::string _label):
 
 Node::~Node()
 {
+    // this node must not be flagged as dirty by its container once deleted (cf. flagAsDirty())
+    parentContainer = nullptr;
+
     // Disconnect and clear wires
     std::for_each(wires.crbegin(), wires.crend(), [](auto item) {
        Node::Disconnect(item);
     });
 
 	// Delete all components
-	for(auto pair : components)
+	for(auto component : components)
 	{
-		delete pair.second;
+		delete component;
 	}
 
 }
 
+void Node::indexComponent(Component* _component)
+{
+	for (auto id : Component::GetTypeIds(_component->getClass()))
+	{
+		if (componentsByType[id] == nullptr)
+			componentsByType[id] = _component;
+	}
+}
+
+void Node::removeComponent(Component* _component)
+{
+	components.erase(std::find(components.begin(), components.end(), _component));
+
+	// A base class id may now point to another Component, so we index all of them again.
+	componentsByType.fill(nullptr);
+	for (auto each : components)
+		indexComponent(each);
+}
+
 bool Node::isDirty()const
 {
 	return dirty;
@@ -94,6 +118,23 @@ void Node::setDirty(bool _value)
 	dirty = _value;
 }
 
+void Node::flagAsDirty()
+{
+	if (parentContainer != nullptr)
+		parentContainer->setDirty(this);
+	else
+		setDirty();
+}
+
+void Node::setReadersDirty(const Member* _member)
+{
+	for (auto wire : wires)
+	{
+		if (wire->getSource() == _member && wire->getTarget() != nullptr)
+			wire->getTarget()->getOwner()->as<Node>()->setDirty();
+	}
+}
+
 Container* Node::getParentContainer()const
 {
 	return this->parentContainer;
@@ -122,6 +163,9 @@ const char* Node::getLabel()const
 void Nodable::Node::addWire(Wire* _wire)
 {
 	wires.push_back(_wire);
+
+	if (parentContainer != nullptr)
+		parentContainer->invalidateSchedule();
 }
 
 void Nodable::Node::removeWire(Wire* _wire)
@@ -129,6 +173,9 @@ void Nodable::Node::removeWire(Wire* _wire)
 	auto found = std::find(wires.begin(), wires.end(), _wire);
 	if(found != wires.end())
 		wires.erase(found);
+
+	if (parentContainer != nullptr)
+		parentContainer->invalidateSchedule();
 }
 
 std::vector<Wire*>& Node::getWires()
@@ -158,6 +205,16 @@ int Node::getOutputWireCount()const
 	return count;
 }
 
+void Node::updateInputs()
+{
+	for (auto wire : wires)
+	{
+		auto target = wire->getTarget();
+		if (target->getOwner() == this && wire->getSource() != nullptr)
+			target->updateValueFromInputMemberValue();
+	}
+}
+
 UpdateResult Node::update()
 {
     // TODO: take in account the result of component's update()
@@ -178,7 +235,12 @@ UpdateResult Node::update()
 void Node::onMemberValueChanged(const char* _name)
 {	
 	updateLabel();
-	NodeTraversal::SetDirty(this);
+	setDirty();
+
+	// The readers of a changed output can't wait for this node to be evaluated (its value may not change again).
+	auto member = get(_name);
+	if (member != nullptr && member->allowsConnection(Way_Out))
+		setReadersDirty(member);
 }
 
 Container *Node::getInnerContainer() const
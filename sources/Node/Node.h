@@ -3,12 +3,13 @@
 // std
 #include <string>
 #include <memory>
+#include <atomic>
+#include <array>
 
 // Nodable
 #include <Core/Nodable.h>
 #include <Core/Object.h>
 #include <Component/Component.h>
-#include <Node/NodeTraversal.h>
 
 namespace Nodable{
 
@@ -40,7 +41,7 @@ namespace Nodable{
 	     * Create a new Node
 	     * @param _label
 	     */
-		explicit Node(std::string  _label = "UnnamedNode");
+		explicit Node(std::string  _label = "UnnamedNode", Arena* _arena = nullptr);
 
 		~Node() override;
 
@@ -102,9 +103,25 @@ namespace Nodable{
 		/** Force this node to be evaluated at the next update() call */
 		void setDirty(bool _value = true);
 
+		/** Same as setDirty(), deferred if a transaction is open in the parent container (cf. Container::setDirty()) */
+		void flagAsDirty();
+
 		/** return true if this node needs to be updated and false otherwise */
 		[[nodiscard]] bool isDirty()const;
+
+		/** Force the nodes connected to the output _member to be evaluated at the next update() call.
+		 * note: only direct readers are flagged, their own readers will be flagged if their values change (cf. Container::update()) */
+		void setReadersDirty(const Member* _member);
 		
+		/** Set the structural hash of the expression this node was built from (cf. Parser) */
+		void setSourceHash(size_t _hash) { sourceHash = _hash; }
+
+		/** Get the structural hash of the expression this node was built from, 0 if not built by a Parser */
+		[[nodiscard]] size_t getSourceHash()const { return sourceHash; }
+
+		/** Transfer the values of each input connected Member from its source Member */
+		void updateInputs();
+
 		/** Update the state of this (and only this) node */
 		virtual UpdateResult update();
 
@@ -124,8 +141,8 @@ namespace Nodable{
 		void addComponent(T* _component)
 		{
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			std::string name(T::GetClass()->getName());
-			components.emplace(std::make_pair(name, _component));
+			components.push_back(_component);
+			indexComponent(_component);
 			_component->setOwner(this);
 		}
 
@@ -157,10 +174,11 @@ namespace Nodable{
 		void deleteComponent()
 		{
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			auto name = T::GetClass()->getName();
-			auto component = getComponent<T>();
-			components.erase(name);
-			delete component;
+			if (auto component = getComponent<T>())
+			{
+				removeComponent(component);
+				delete component;
+			}
 		}
 
 		 /**
@@ -172,32 +190,22 @@ namespace Nodable{
 		T* getComponent()const
 		{
 			static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-			auto c = T::GetClass();
-			auto name = c->getName();
-
-			// Search with class name
-			{
-				auto it = components.find(name);
-				if (it != components.end()) {
-					return reinterpret_cast<T*>(it->second);
-				}
-			}
-
-			// Search for a derived class
-			for (const auto & it : components) {
-				Component* component = it.second;
-				if (component->getClass()->isChildOf(c, false)) {
-					return reinterpret_cast<T*>(component);
-				}
-			}
-
-			return nullptr;
+			return static_cast<T*>(componentsByType[Component::TypeId<T>()]);
 		};
 
 	protected:
 		Components components;
 
 	private:
+		/* Store _component at its type id and at the ones of its base classes (if free) */
+		void indexComponent(Component* _component);
+
+		/* Remove _component without deleting it */
+		void removeComponent(Component* _component);
+
+		/* Components by type id (cf. Component::TypeId<T>()), a base class id points to the first added derived Component */
+		std::array<Component*, Component::TypeCount> componentsByType{};
+
 		/**
 		 * This will be called automatically after a Member value change.
 		 * @param _name is the name of the Member that has changed.
@@ -213,11 +221,14 @@ namespace Nodable{
 		/** Label of the Node, will be visible */
 		std::string               label;
 
-        /** true means: needs to be evaluated. */
-		bool                      dirty;
+        /** true means: needs to be evaluated. (atomic: several inputs evaluated in parallel can flag the same node) */
+		std::atomic<bool>         dirty;
 
         /** contains all wires connected to or from this node.*/
 		Wires  wires;
+
+		/** structural hash of the expression this node was built from (cf. Parser reconciliation) */
+		size_t                    sourceHash = 0;
 	
 	public:
 		MIRROR_CLASS(Node)(
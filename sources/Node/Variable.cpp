@@ -4,9 +4,9 @@
 
 using namespace Nodable;
 
-Variable::Variable():Node("Variable")
+Variable::Variable(Arena* _arena):Node("Variable", _arena)
 {
-	add("value", Visibility::Always, Type::Any, Way_InOut);	
+	value = add("value", Visibility::Always, Type::Any, Way_InOut);
 }
 
 Variable::~Variable()
@@ -19,7 +19,7 @@ void Variable::setName(const char* _name)
 {
 	name = _name;
 	setLabel(_name);
-	get("value")->setSourceExpression(_name);
+	value->setSourceExpression(_name);
 }
 
 const char* Variable::getName()const
@@ -16,7 +16,7 @@ namespace Nodable{
 	*/
 	class Variable : public Node {
 	public:
-		Variable();
+		explicit Variable(Arena* _arena = nullptr);
 		~Variable();
 
 		void              setName         (const char*);
@@ -25,27 +25,28 @@ namespace Nodable{
 		const char*       getName         ()const;
 
 		Member* getMember()const {
-			return get("value");
+			return value;
 		}
 
 		std::string       getTypeAsString ()const;
 
 	private:
 		std::string       name;
+		Member*           value; /* resolved once, this is the most accessed member */
 
 	public:
 
 		template<class Value>
 		void set(Value _value)
 		{
-			get("value")->set(_value);
+			value->set(_value);
 			updateLabel();
 		};
 
 		template<class Value>
 		void set(Value* _value)
 		{
-			get("value")->set(_value);
+			value->set(_value);
 			updateLabel();
 		};
 
@@ -0,0 +1,34 @@
+#pragma once
+#include <Component/Container.h>
+#include <Node/Variable.h>
+
+namespace Nodable
+{
+    /*
+        Graphs built node by node (without Parser) shared by the tests.
+    */
+
+    /* result = a + b, the result is created before its inputs (creation order must not matter) */
+    struct AdditionGraph
+    {
+        AdditionGraph(Container& _container, double _a = 2, double _b = 3, bool _connected = true)
+        {
+            result = _container.newResult();
+            add    = _container.newBinOp(Language::Nodable()->findOperator("+"));
+            a      = _container.newNumber(_a);
+            b      = _container.newNumber(_b);
+
+            if (_connected)
+            {
+                Node::Connect(a->getMember(), add->get("lvalue"));
+                Node::Connect(b->getMember(), add->get("rvalue"));
+                Node::Connect(add->get("result"), result->getMember());
+            }
+        }
+
+        Variable* result;
+        Node*     add;
+        Variable* a;
+        Variable* b;
+    };
+}
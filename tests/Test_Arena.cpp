@@ -0,0 +1,59 @@
+#include "gtest/gtest.h"
+#include <Core/Pool.h>
+#include <Core/Arena.h>
+
+using namespace Nodable;
+
+TEST(Arena, Pool_reuses_freed_slots)
+{
+    Pool<double, 4> pool;
+    auto a = pool.create(1.0);
+    auto b = pool.create(2.0);
+
+    EXPECT_EQ(b, a + 1);    // contiguous
+    EXPECT_EQ(*b, 2.0);
+
+    pool.destroy(a);
+    EXPECT_EQ(pool.create(3.0), a);
+    EXPECT_EQ(pool.size(), size_t(2));
+
+    std::vector<double*> others;
+    for (int i = 0; i < 4; i++)
+        others.push_back(pool.create(0.0));
+    EXPECT_EQ(pool.capacity(), size_t(8));
+
+    // destroy all (in any order) and reset: allocations start again from the first slot
+    pool.destroy(b);
+    pool.destroy(a);
+    for (auto each : others)
+        pool.destroy(each);
+    EXPECT_EQ(pool.size(), size_t(0));
+
+    pool.reset();
+    EXPECT_EQ(pool.create(4.0), a);
+    pool.destroy(a);
+}
+
+TEST(Arena, Objects_use_their_arena)
+{
+    Arena arena;
+    auto variable = arena.create<Variable>();
+    auto node     = arena.create<Node>("Node");
+
+    EXPECT_EQ(variable->getArena(), &arena);
+    EXPECT_EQ(node->getLabel(), std::string("Node"));
+    EXPECT_GT(arena.size(), size_t(2));  // members and connectors are in the arena too
+
+    auto wire = Node::Connect(variable->getMember(), node->add("in", Visibility::Default, Type::Any, Way_In));
+    Node::Disconnect(wire);
+
+    Arena::Delete(variable);
+    Arena::Delete(node);
+    EXPECT_EQ(arena.size(), size_t(0));
+
+    // Memory is reused in address order after a reset
+    arena.reset();
+    auto first = arena.create<Node>("First");
+    EXPECT_EQ(first, node);
+    Arena::Delete(first);
+}
@@ -0,0 +1,297 @@
+#include "gtest/gtest.h"
+#include <Component/Container.h>
+#include <Language/Parser.h>
+#include <Language/Compiler.h>
+#include <Language/NativeCompiler.h>
+#include <Core/Program.h>
+#include <Node/Variable.h>
+#include <Component/ComputeFunction.h>
+#include <cmath>
+#include "TestGraphs.h"
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+
+using namespace Nodable;
+
+template <typename T>
+T EvalCompiled(const std::string& _expression)
+{
+    Container container(Language::Nodable());
+    container.setEvaluationMode(Container::EvaluationMode::Compiled);
+    Parser parser(Language::Nodable(), &container);
+    EXPECT_TRUE(parser.eval(_expression));
+    EXPECT_NE(container.getProgram(), nullptr);
+    container.update();
+    auto result = container.getResultVariable();
+    return result ? (T)*result->getMember() : T();
+}
+
+TEST(Compiler, Numeric_expressions)
+{
+    EXPECT_EQ(EvalCompiled<double>("1+2*3"), double(7));
+    EXPECT_EQ(EvalCompiled<double>("(1+2)*(3+4)-(5*6)/(7-8)"), double(51));
+    EXPECT_EQ(EvalCompiled<double>("-(2+3)"), double(-5));
+    EXPECT_EQ(EvalCompiled<double>("pow(2,10)+sqrt(16)"), double(1028));
+    EXPECT_EQ(EvalCompiled<double>("mod(7,4)"), double(3));
+    EXPECT_EQ(EvalCompiled<double>("mod(7.5,4)"), double(3));
+    EXPECT_TRUE(std::isnan(EvalCompiled<double>("mod(5,0)")));
+}
+
+TEST(Compiler, Boolean_expressions)
+{
+    EXPECT_TRUE(EvalCompiled<bool>("2>1"));
+    EXPECT_TRUE(EvalCompiled<bool>("not(1>2)"));
+    EXPECT_TRUE(EvalCompiled<bool>("true&&(false||true)"));
+    EXPECT_FALSE(EvalCompiled<bool>("true=>false"));
+}
+
+TEST(Compiler, Assign)
+{
+    Container container(Language::Nodable());
+    container.setEvaluationMode(Container::EvaluationMode::Compiled);
+    Parser parser(Language::Nodable(), &container);
+    parser.eval("a=5*2");
+    ASSERT_NE(container.getProgram(), nullptr);
+    container.update();
+
+    EXPECT_EQ((double)*container.getResultVariable()->getMember(), double(10));
+}
+
+TEST(Compiler, Fallback_with_strings)
+{
+    Container container(Language::Nodable());
+    container.setEvaluationMode(Container::EvaluationMode::Compiled);
+    Parser parser(Language::Nodable(), &container);
+    parser.eval("\"hello\"+\"world\"");
+
+    EXPECT_EQ(container.getProgram(), nullptr);
+    container.update();
+    EXPECT_EQ((std::string)*container.getResultVariable()->getMember(), "helloworld");
+}
+
+TEST(Compiler, Functions_are_matched_by_Function_not_by_identifier)
+{
+    // Same signature as the native "sin", other semantics
+    auto sine = Language::Nodable()->findFunction(FunctionSignature::Create(TokenType::DoubleType, "sin", TokenType::DoubleType));
+    ASSERT_NE(sine, nullptr);
+    Function twice(sine->signature, [](Member* _result, const std::vector<Member*>& _args) {
+        _result->set((double)ARG(0) * 2.0);
+        return 0;
+    });
+
+    Container container(Language::Nodable());
+    container.setEvaluationMode(Container::EvaluationMode::Compiled);
+    auto result = container.newResult();
+    auto node   = container.newFunction(&twice);
+    auto number = container.newNumber(3);
+    Node::Connect(number->getMember(), node->getComponent<ComputeFunction>()->getArgs()[0]);
+    Node::Connect(node->get("result"), result->getMember());
+
+    EXPECT_EQ(container.getProgram(), nullptr);
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(6));
+}
+
+TEST(Compiler, Program_is_rerun_after_an_edit)
+{
+    Container container(Language::Nodable());
+    container.setEvaluationMode(Container::EvaluationMode::Compiled);
+
+    AdditionGraph graph(container);
+    auto [result, add, a, b] = graph;
+
+    auto program = container.getProgram();
+    ASSERT_NE(program, nullptr);
+    EXPECT_EQ(program->getInstructionCount(), size_t(1));
+
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(5));
+    EXPECT_FALSE(add->isDirty());
+
+    a->Node::set("value", double(10));
+    container.update();
+    EXPECT_EQ((double)*add->get("lvalue"), double(10));
+    EXPECT_EQ((double)*result->getMember(), double(13));
+    EXPECT_EQ(container.getProgram(), program); // not recompiled
+}
+
+TEST(Compiler, Batch_evaluation)
+{
+    Container container(Language::Nodable());
+    auto language = Language::Nodable();
+
+    // result = a * 2 + b
+    auto result = container.newResult();
+    auto a      = container.newVariable("a");
+    auto b      = container.newVariable("b");
+    auto two    = container.newNumber(2);
+    auto mult   = container.newBinOp(language->findOperator("*"));
+    auto add    = container.newBinOp(language->findOperator("+"));
+
+    Node::Connect(a->getMember(), mult->get("lvalue"));
+    Node::Connect(two->getMember(), mult->get("rvalue"));
+    Node::Connect(mult->get("result"), add->get("lvalue"));
+    Node::Connect(b->getMember(), add->get("rvalue"));
+    Node::Connect(add->get("result"), result->getMember());
+
+    // more rows than Program::BatchSize, and not a multiple of it
+    const size_t rowCount = Program::BatchSize * 3 + 7;
+    std::vector<double> as(rowCount), results(rowCount);
+    for (size_t row = 0; row < rowCount; row++)
+        as[row] = double(row);
+
+    container.bindColumn(a, as.data());
+    b->set(double(1));
+
+    ASSERT_TRUE(container.evaluateBatch(rowCount, results.data()));
+    for (size_t row = 0; row < rowCount; row++)
+        EXPECT_EQ(results[row], as[row] * 2 + 1);
+
+    // a result of another type is refused
+    std::unique_ptr<bool[]> booleans(new bool[rowCount]);
+    EXPECT_FALSE(container.evaluateBatch(rowCount, booleans.get()));
+
+    // nodes are left unchanged
+    EXPECT_TRUE(result->getMember()->isType(Type::Any));
+}
+
+TEST(Compiler, Batch_evaluation_with_zero_divisors)
+{
+    Container container(Language::Nodable());
+
+    // result = mod(x, y)
+    auto mod    = Language::Nodable()->findFunction(FunctionSignature::Create(TokenType::DoubleType, "mod", TokenType::DoubleType, TokenType::DoubleType));
+    ASSERT_NE(mod, nullptr);
+
+    auto result = container.newResult();
+    auto x      = container.newVariable("x");
+    auto y      = container.newVariable("y");
+    auto call   = container.newFunction(mod);
+    auto& args  = call->getComponent<ComputeFunction>()->getArgs();
+
+    Node::Connect(x->getMember(), args[0]);
+    Node::Connect(y->getMember(), args[1]);
+    Node::Connect(call->get("result"), result->getMember());
+
+    const double xColumn[] = {7,  7.5, -7, 5, 1e300};
+    const double yColumn[] = {4,  4,   3,  0, 7};
+    double       results[5];
+
+    container.bindColumn(x, xColumn);
+    container.bindColumn(y, yColumn);
+    ASSERT_TRUE(container.evaluateBatch(5, results));
+
+    EXPECT_EQ(results[0], double(3));
+    EXPECT_EQ(results[1], double(3));
+    EXPECT_EQ(results[2], double(-1));
+    EXPECT_TRUE(std::isnan(results[3]));
+    EXPECT_EQ(results[4], std::fmod(1e300, 7.0));
+}
+
+TEST(Compiler, Batch_evaluation_with_boolean_columns)
+{
+    Container container(Language::Nodable());
+    auto language = Language::Nodable();
+
+    // result = enabled && x > 3
+    auto result  = container.newResult();
+    auto enabled = container.newVariable("enabled");
+    auto x       = container.newVariable("x");
+    auto three   = container.newNumber(3);
+    auto greater = container.newBinOp(language->findOperator(">"));
+    auto andOp   = container.newBinOp(language->findOperator("&&"));
+
+    Node::Connect(x->getMember(), greater->get("lvalue"));
+    Node::Connect(three->getMember(), greater->get("rvalue"));
+    Node::Connect(enabled->getMember(), andOp->get("lvalue"));
+    Node::Connect(greater->get("result"), andOp->get("rvalue"));
+    Node::Connect(andOp->get("result"), result->getMember());
+
+    const bool   enabledColumn[] = {true, true, false, true, false};
+    const double xColumn[]       = {5,    1,    5,     4,    0};
+    bool         results[5];
+
+    container.bindColumn(enabled, enabledColumn);
+    container.bindColumn(x, xColumn);
+    ASSERT_TRUE(container.evaluateBatch(5, results));
+
+    for (size_t row = 0; row < 5; row++)
+        EXPECT_EQ(results[row], enabledColumn[row] && xColumn[row] > 3);
+}
+
+TEST(Compiler, Native_code_source)
+{
+    Program program;
+    auto a = program.newRegister(Type::Double);
+    auto b = program.newRegister(Type::Double);
+    auto c = program.newRegister(Type::Boolean);
+    program.push(OpCode::Multiply, a, a, b);
+    program.push(OpCode::Greater, c, a, b);
+
+    auto source = NativeCompiler::GenerateSource(program);
+    EXPECT_NE(source.find(NativeCompiler::EntryPoint), std::string::npos);
+    EXPECT_NE(source.find("n[0] = n[0] * n[1];"), std::string::npos);
+    EXPECT_NE(source.find("b[0] = n[0] >  n[1];"), std::string::npos);
+}
+
+TEST(Compiler, Native_evaluation)
+{
+    // results must be the same with or without a system compiler (interpreter fallback)
+    Container container(Language::Nodable());
+    container.setEvaluationMode(Container::EvaluationMode::Native);
+
+    AdditionGraph graph(container);
+    auto [result, add, a, b] = graph;
+
+    ASSERT_NE(container.getProgram(), nullptr);
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(5));
+
+    a->Node::set("value", double(10));
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(13));
+
+    // the native code is built in background once the program has run NativeCompilationRuns times
+    for (size_t i = 0; i < Container::NativeCompilationRuns; i++)
+    {
+        b->Node::set("value", double(i));
+        container.update();
+        EXPECT_EQ((double)*result->getMember(), double(10 + i));
+    }
+
+    if (NativeCompiler::IsSupported() && std::system("c++ --version > /dev/null 2>&1") == 0)
+    {
+        auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+        while (!container.getProgram()->hasNativeCode() && std::chrono::steady_clock::now() < timeout)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        ASSERT_TRUE(container.getProgram()->hasNativeCode());
+        b->Node::set("value", double(-4));
+        container.update();
+        EXPECT_EQ((double)*result->getMember(), double(6));
+    }
+
+    // back to the interpreter
+    container.setEvaluationMode(Container::EvaluationMode::Compiled);
+    ASSERT_NE(container.getProgram(), nullptr);
+    EXPECT_FALSE(container.getProgram()->hasNativeCode());
+}
+
+TEST(Compiler, Native_compilation_failure)
+{
+    Container container(Language::Nodable());
+    container.setEvaluationMode(Container::EvaluationMode::Compiled);
+    Parser parser(Language::Nodable(), &container);
+    EXPECT_TRUE(parser.eval("a = 3; a * 2 + 1"));
+
+    // "false" fails like a missing compiler, the program is left unchanged
+    auto program = container.getProgram();
+    ASSERT_NE(program, nullptr);
+    EXPECT_FALSE(NativeCompiler("false").compile(*program));
+    EXPECT_FALSE(program->hasNativeCode());
+
+    container.update();
+    EXPECT_EQ((double)*container.getResultVariable()->getMember(), double(7));
+    EXPECT_FALSE(container.getProgram()->hasNativeCode());
+}
@@ -0,0 +1,282 @@
+#include "gtest/gtest.h"
+#include <Component/Container.h>
+#include <Language/Parser.h>
+#include <Node/Variable.h>
+#include <Core/Wire.h>
+#include <Component/ComputeFunction.h>
+#include "TestGraphs.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace Nodable;
+
+TEST(Container, Schedule_sorts_inputs_first)
+{
+    Container container(Language::Nodable());
+
+    // the consumer is created before its inputs to check that creation order does not matter
+    AdditionGraph graph(container);
+    auto [result, add, a, b] = graph;
+
+    const auto& schedule = container.getSchedule();
+    auto indexOf = [&](Node* _node){ return std::find(schedule.begin(), schedule.end(), _node) - schedule.begin(); };
+
+    EXPECT_EQ(schedule.size(), container.getNodeCount());
+    EXPECT_LT(indexOf(a), indexOf(add));
+    EXPECT_LT(indexOf(b), indexOf(add));
+    EXPECT_LT(indexOf(add), indexOf(result));
+
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(5));
+}
+
+TEST(Container, Schedule_is_rebuilt_after_disconnect)
+{
+    Container container(Language::Nodable());
+    Parser parser(Language::Nodable(), &container);
+    parser.eval("1+2");
+    container.update();
+
+    auto result = container.getResultVariable();
+    EXPECT_EQ((double)*result->getMember(), double(3));
+
+    Node::Disconnect(result->getWires().front());
+    auto& schedule = container.getSchedule();
+    EXPECT_EQ(schedule.size(), container.getNodeCount());
+}
+
+TEST(Container, Parallel_evaluation_matches_sequential)
+{
+    auto evaluate = [](Container::EvaluationMode _mode) -> double
+    {
+        Container container(Language::Nodable());
+        container.setEvaluationMode(_mode);
+        Parser parser(Language::Nodable(), &container);
+        parser.eval("(1+2)*(3+4)-(5*6)/(7-8)+(9-10)*(11+12)");
+        container.update();
+        return (double)*container.getResultVariable()->getMember();
+    };
+
+    auto expected = evaluate(Container::EvaluationMode::Sequential);
+    EXPECT_EQ(expected, double(21 + 30 - 23));
+    EXPECT_EQ(evaluate(Container::EvaluationMode::Parallel), expected);
+}
+
+TEST(Container, Parallel_evaluation_respects_dirty_flags)
+{
+    Container container(Language::Nodable());
+    container.setEvaluationMode(Container::EvaluationMode::Parallel);
+
+    AdditionGraph graph(container);
+    auto [result, add, a, b] = graph;
+
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(5));
+    EXPECT_FALSE(add->isDirty());
+    EXPECT_FALSE(result->isDirty());
+
+    a->Node::set("value", double(10)); // notifies the change (unlike Variable::set)
+    EXPECT_TRUE(add->isDirty());
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(13));
+    EXPECT_FALSE(result->isDirty());
+}
+
+TEST(Container, Unchanged_output_does_not_dirty_readers)
+{
+    Container container(Language::Nodable());
+
+    auto result  = container.newResult();
+    auto negate  = container.newUnaryOp(Language::Nodable()->findOperator("!"));
+    auto greater = container.newBinOp(Language::Nodable()->findOperator(">"));
+    auto a       = container.newNumber(2);
+    auto b       = container.newNumber(0.0);
+
+    Node::Connect(a->getMember(), greater->get("lvalue"));
+    Node::Connect(b->getMember(), greater->get("rvalue"));
+    Node::Connect(greater->get("result"), negate->get("lvalue"));
+    Node::Connect(negate->get("result"), result->getMember());
+
+    container.update();
+    EXPECT_FALSE((bool)*result->getMember());
+
+    // 3 > 0 is still true, negate must not be evaluated (we check it using a value it would overwrite)
+    negate->get("result")->set(true);
+    a->Node::set("value", double(3));
+    EXPECT_TRUE(greater->isDirty());
+    EXPECT_FALSE(negate->isDirty());
+
+    container.update();
+    EXPECT_FALSE(greater->isDirty());
+    EXPECT_TRUE((bool)*negate->get("result"));
+
+    // but source expressions are still up to date
+    auto expression = result->getMember()->getSourceExpression();
+    EXPECT_NE(expression.find(a->getMember()->getSourceExpression()), std::string::npos);
+
+    // -1 > 0 is false, the change is propagated
+    negate->get("result")->set(false);
+    a->Node::set("value", double(-1));
+    container.update();
+    EXPECT_TRUE((bool)*result->getMember());
+}
+
+TEST(Container, Long_chain_evaluation)
+{
+    // x feeds both operands of the first "+" (a diamond), then 5000 "+ 1" are chained to the result
+    const size_t count = 5000;
+    Container container(Language::Nodable());
+    auto plus = Language::Nodable()->findOperator("+");
+    auto x    = container.newNumber(0.0);
+
+    auto first = container.newBinOp(plus);
+    Node::Connect(x->getMember(), first->get("lvalue"));
+    Node::Connect(x->getMember(), first->get("rvalue"));
+
+    Member* last = first->get("result");
+    for (size_t i = 0; i < count; i++)
+    {
+        auto add = container.newBinOp(plus);
+        Node::Connect(last, add->get("lvalue"));
+        add->get("rvalue")->set(1.0);
+        last = add->get("result");
+    }
+    auto result = container.newResult();
+    Node::Connect(last, result->getMember());
+
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(count));
+
+    // each node is evaluated once, following the schedule (no traversal from x)
+    x->Node::set("value", double(10));
+    EXPECT_TRUE(first->isDirty());
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(20 + count));
+    EXPECT_FALSE(result->isDirty());
+}
+
+TEST(Container, Demand_driven_evaluation)
+{
+    for (auto mode : {Container::EvaluationMode::Sequential, Container::EvaluationMode::Parallel, Container::EvaluationMode::Compiled})
+    {
+        Container container(Language::Nodable());
+        container.setEvaluationMode(mode);
+        container.setDemandDriven(true);
+
+        // result = 2 + 3
+        AdditionGraph graph(container);
+        auto result = graph.result;
+
+        // an unused subgraph: 4 * 5
+        auto mult = container.newBinOp(Language::Nodable()->findOperator("*"));
+        auto c    = container.newNumber(4);
+        auto d    = container.newNumber(5);
+        Node::Connect(c->getMember(), mult->get("lvalue"));
+        Node::Connect(d->getMember(), mult->get("rvalue"));
+
+        EXPECT_EQ(container.getSchedule().size(), size_t(4));
+
+        container.update();
+        EXPECT_EQ((double)*result->getMember(), double(5));
+        EXPECT_TRUE(mult->isDirty());
+
+        // once watched, the subgraph is evaluated
+        container.watch(mult->get("result"));
+        container.update();
+        EXPECT_FALSE(mult->isDirty());
+        EXPECT_EQ((double)*mult->get("result"), double(20));
+
+        // back to the whole graph
+        container.unwatch(mult->get("result"));
+        container.setDemandDriven(false);
+        EXPECT_EQ(container.getSchedule().size(), container.getNodeCount());
+    }
+}
+
+TEST(Container, Pure_functions_are_memoized)
+{
+    Container container(Language::Nodable());
+    auto language = Language::Nodable();
+
+    // result = sqrt(x)
+    auto sqrt   = language->findFunction(FunctionSignature::Create(TokenType::DoubleType, "sqrt", TokenType::DoubleType));
+    ASSERT_NE(sqrt, nullptr);
+
+    auto result = container.newResult();
+    auto x      = container.newNumber(16);
+    auto call   = container.newFunction(sqrt);
+    auto memo   = call->getComponent<ComputeFunction>();
+    ASSERT_TRUE(memo->isMemoEnabled());
+
+    Node::Connect(x->getMember(), memo->getArgs()[0]);
+    Node::Connect(call->get("result"), result->getMember());
+
+    // flip x back and forth
+    for (auto value : {16.0, 25.0, 16.0, 25.0})
+    {
+        x->Node::set("value", value);
+        container.update();
+        EXPECT_EQ((double)*result->getMember(), std::sqrt(value));
+    }
+
+    EXPECT_EQ(memo->getMemoMisses(), size_t(2));
+    EXPECT_EQ(memo->getMemoHits(), size_t(2));
+
+    // operators are not memoized
+    auto add = container.newBinOp(language->findOperator("+"));
+    EXPECT_FALSE(add->getComponent<ComputeFunction>()->isMemoEnabled());
+}
+
+TEST(Container, Transaction_defers_evaluation)
+{
+    Container container(Language::Nodable());
+
+    AdditionGraph graph(container, 2, 3, false);
+    auto [result, add, a, b] = graph;
+    container.update();
+
+    container.beginTransaction();
+    {
+        Container::Transaction nested(&container);
+        Node::Connect(a->getMember(), add->get("lvalue"));
+        Node::Connect(b->getMember(), add->get("rvalue"));
+    }
+    EXPECT_TRUE(container.isInTransaction());
+    EXPECT_FALSE(add->isDirty()); // flagged on commit
+
+    Node::Connect(add->get("result"), result->getMember());
+    container.update(); // nothing is evaluated within a transaction
+    EXPECT_FALSE(result->getMember()->isType(Type::Double));
+
+    container.commitTransaction();
+    EXPECT_FALSE(container.isInTransaction());
+    EXPECT_TRUE(add->isDirty());
+
+    container.update();
+    EXPECT_EQ((double)*result->getMember(), double(5));
+}
+
+TEST(Container, Native_function_arguments_are_converted)
+{
+    Container container(Language::Nodable());
+    auto language = Language::Nodable();
+
+    // a hand-made connection of a variable to sqrt(number)
+    auto sqrt   = language->findFunction(FunctionSignature::Create(TokenType::DoubleType, "sqrt", TokenType::DoubleType));
+    auto x      = container.newVariable("x");
+    auto call   = container.newFunction(sqrt);
+    auto& args  = call->getComponent<ComputeFunction>()->getArgs();
+    Node::Connect(x->getMember(), args[0]);
+
+    // undefined, read as 0
+    container.update();
+    EXPECT_EQ((double)*call->get("result"), double(0));
+
+    x->Node::set("value", int64_t(16));
+    container.update();
+    EXPECT_EQ((double)*call->get("result"), double(4));
+
+    x->Node::set("value", true);
+    container.update();
+    EXPECT_EQ((double)*call->get("result"), double(1));
+}
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include <Language/Language.h>
+#include <Language/LanguageNodable.h>
+#include <Language/NativeFunction.h>
+#include <Core/Member.h>
+#include <Component/Container.h>
+#include <Language/Parser.h>
+
+using namespace Nodable;
+
+TEST(Language, Find_overloads)
+{
+    auto language = Language::Nodable();
+
+    auto numbers = FunctionSignature::Create(TokenType::DoubleType, "operator+", TokenType::DoubleType, TokenType::DoubleType);
+    auto strings = FunctionSignature::Create(TokenType::StringType, "operator+", TokenType::StringType, TokenType::StringType);
+    auto unknown = FunctionSignature::Create(TokenType::DoubleType, "operator+", TokenType::DoubleType, TokenType::DoubleType, TokenType::DoubleType);
+
+    auto numbersOperator = language->findOperator(numbers);
+    auto stringsOperator = language->findOperator(strings);
+
+    ASSERT_NE(numbersOperator, nullptr);
+    ASSERT_NE(stringsOperator, nullptr);
+    EXPECT_NE(numbersOperator, stringsOperator);
+    EXPECT_TRUE(stringsOperator->signature.match(strings));
+
+    // second lookups are answered by the cache, results must be the same
+    EXPECT_EQ(language->findOperator(numbers), numbersOperator);
+    EXPECT_EQ(language->findOperator(strings), stringsOperator);
+
+    EXPECT_EQ(language->findOperator(unknown), nullptr);
+    EXPECT_EQ(language->findFunction(unknown), nullptr);
+}
+
+TEST(Language, Find_operator_by_identifier)
+{
+    auto language = Language::Nodable();
+
+    EXPECT_EQ(language->findOperator(">=")->identifier, ">=");
+    EXPECT_EQ(language->findOperator("<=>")->identifier, "<=>");
+    EXPECT_EQ(language->findOperator("?"), nullptr);
+}
+
+TEST(Language, Native_functions)
+{
+    LanguageNodable language;
+    language.addToAPI(+[](double _a, bool _b) { return _b ? _a * 10.0 : _a; }, "tenTimesIf");
+    language.addToAPI(+[](const std::string& _a, int64_t _b) { return _a + std::to_string(_b); }, "concat");
+
+    // signatures are deduced from C++ types
+    auto signature = FunctionSignature::Create(TokenType::DoubleType, "tenTimesIf", TokenType::DoubleType, TokenType::BooleanType);
+    auto function  = language.findFunction(signature);
+    ASSERT_NE(function, nullptr);
+    EXPECT_EQ(function->signature.getType(), TokenType::DoubleType);
+    EXPECT_TRUE(function->isCallable());
+
+    Member a(nullptr), b(nullptr), result(nullptr);
+    a.set(4.0);
+    b.set(true);
+    EXPECT_EQ(function->call(&result, {&a, &b}), 0);
+    EXPECT_EQ((double)result.getData(), 40.0);
+
+    auto concat = language.findFunction(FunctionSignature::Create(TokenType::StringType, "concat", TokenType::StringType, TokenType::Int64Type));
+    ASSERT_NE(concat, nullptr);
+    a.set("abc");
+    b.set(int64_t(12));
+    EXPECT_EQ(concat->call(&result, {&a, &b}), 0);
+    EXPECT_EQ((std::string)result.getData(), "abc12");
+}
+
+TEST(Language, Functions_are_impure_unless_registered_as_pure)
+{
+    LanguageNodable language;
+    language.addToAPI(+[](double _x) { return _x + 1.0; }, "next");
+    language.addToAPI(+[](double _x) { return _x * 2.0; }, "twice", Language::Pure);
+
+    auto next  = language.findFunction(FunctionSignature::Create(TokenType::DoubleType, "next", TokenType::DoubleType));
+    auto twice = language.findFunction(FunctionSignature::Create(TokenType::DoubleType, "twice", TokenType::DoubleType));
+    ASSERT_NE(next, nullptr);
+    ASSERT_NE(twice, nullptr);
+    EXPECT_FALSE(next->pure);
+    EXPECT_TRUE(twice->pure);
+
+    // builtins are registered explicitly, assignments are impure
+    EXPECT_TRUE(Language::Nodable()->findOperator("+")->pure);
+    EXPECT_FALSE(Language::Nodable()->findOperator("=")->pure);
+
+    // only pure calls are folded while parsing
+    auto nodeCount = [&](const std::string& _expression) {
+        Container container(&language);
+        Parser parser(&language, &container);
+        parser.setOptimizationEnabled(true);
+        EXPECT_TRUE(parser.eval(_expression));
+        return container.getNodeCount();
+    };
+    EXPECT_EQ(nodeCount("twice(1)"), size_t(1));
+    EXPECT_EQ(nodeCount("next(1)"), size_t(2));
+}
@@ -84,4 +84,55 @@ TEST(Member, Type_Double)
     EXPECT_EQ((double)*m, (double)50);
     EXPECT_EQ(m->getType(), Type::Double);
     EXPECT_TRUE(m->isDefined());
-}
\ No newline at end of file
+}
+TEST(Member, Type_String_long)
+{
+    auto m = std::make_unique<Member>(nullptr);
+    const std::string str = "A string too long to be stored inline.";
+    m->set(str);
+
+    auto copy = std::make_unique<Member>(nullptr);
+    copy->set(m.get());
+
+    EXPECT_EQ((std::string)*copy, str);
+    EXPECT_TRUE(copy->getData() == m->getData());
+
+    m->set("short");
+    EXPECT_EQ((std::string)*m, "short");
+    EXPECT_EQ((std::string)*copy, str);
+}
+
+TEST(Member, Type_String_from_itself)
+{
+    Variant variant;
+    const std::string str = "A string too long to be stored inline.";
+    variant.setString(str.data(), str.size());
+
+    // a view of its own (heap) string, long or short
+    auto view = variant.asString();
+    variant.setString(view.data() + 2, view.size() - 2);
+    EXPECT_EQ(variant.asString(), str.substr(2));
+
+    view = variant.asString();
+    variant.setString(view.data() + 5, 6);
+    EXPECT_EQ(variant.asString(), str.substr(7, 6));
+
+    // and of its own inline string
+    view = variant.asString();
+    variant.setString(view.data() + 1, 3);
+    EXPECT_EQ(variant.asString(), str.substr(8, 3));
+}
+
+TEST(Member, Double_to_string)
+{
+    auto m = std::make_unique<Member>(nullptr);
+
+    m->set(1.5);
+    EXPECT_EQ((std::string)*m, "1.5");
+
+    m->set(-10.0);
+    EXPECT_EQ((std::string)*m, "-10");
+
+    m->set(0.0);
+    EXPECT_EQ((std::string)*m, "0");
+}
@@ -2,6 +2,9 @@
 #include "gtest/gtest.h"
 #include <Core/Member.h>
 #include <Node.h>
+#include <DataAccess.h>
+#include <WireView.h>
+#include <ComputeBase.h>
 
 using namespace Nodable;
 
@@ -16,4 +19,39 @@ TEST(Node, Add_member_Double)
     EXPECT_EQ((double)*val, double(100));
     EXPECT_EQ((std::string)*val, std::to_string(100));
     EXPECT_TRUE((bool)*val);
-}
\ No newline at end of file
+}
+TEST(Node, Member_slots)
+{
+    Node node;
+    const size_t firstSlot = node.getMembers().size();
+    auto first  = node.add("first");
+    auto second = node.add("second");
+
+    EXPECT_EQ(node.getSlot("first"), firstSlot);
+    EXPECT_EQ(node.getSlot("second"), firstSlot + 1);
+    EXPECT_EQ(node.getSlot("unknown"), Object::InvalidSlot);
+    EXPECT_EQ(node.getAt(firstSlot), first);
+    EXPECT_EQ(node.getAt(node.getSlot("second")), second);
+    EXPECT_EQ(node.get("second"), second);
+}
+
+TEST(Node, Components_by_type)
+{
+    Node node;
+    auto dataAccess = new DataAccess;
+    auto view       = new WireView;
+    node.addComponent(dataAccess);
+    node.addComponent(view);
+
+    EXPECT_EQ(node.getComponent<DataAccess>(), dataAccess);
+    EXPECT_EQ(node.getComponent<WireView>(), view);
+    EXPECT_EQ(node.getComponent<View>(), view);             // by base class
+    EXPECT_EQ(node.getComponent<Component>(), dataAccess);  // first added
+    EXPECT_FALSE(node.hasComponent<ComputeBase>());
+
+    node.deleteComponent<DataAccess>();
+
+    EXPECT_FALSE(node.hasComponent<DataAccess>());
+    EXPECT_EQ(node.getComponent<Component>(), view);
+    EXPECT_EQ(node.getComponents().size(), size_t(1));
+}
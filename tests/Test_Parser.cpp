@@ -4,6 +4,9 @@
 #include <Component/Container.h>
 #include <Language/Parser.h>
 #include <Node/Variable.h>
+#include <Component/ComputeFunction.h>
+#include <cmath>
+#include <limits>
 
 using namespace Nodable;
 
@@ -112,3 +115,312 @@ TEST(Parser, Strings)
     EXPECT_TRUE(Parser_Test("b = string(true)", "true"));
     EXPECT_TRUE(Parser_Test("b = string(false)", "false"));
 }
+
+TEST(Parser, Tokens)
+{
+    EXPECT_TRUE(Parser_Test("3 >= 2", true));
+    EXPECT_TRUE(Parser_Test("2 >= 3", false));
+    EXPECT_TRUE(Parser_Test("2 <= 3", true));
+    EXPECT_TRUE(Parser_Test("a = 1 /* comment */ + 2 // comment", 3));
+    EXPECT_TRUE(Parser_Test("trueValue = 4", 4));
+    EXPECT_TRUE(Parser_Test("\"a-b\"", "a-b"));
+}
+
+TEST(Parser, Unary_operators_on_calls)
+{
+    EXPECT_TRUE(Parser_Test("-int(5)", int64_t(-5)));
+    EXPECT_TRUE(Parser_Test("!(1 > 2)", true));
+    EXPECT_TRUE(Parser_Test("-returnNumber(2) * 3", -6));
+}
+
+TEST(Parser, Long_expressions)
+{
+    // long and deeply nested expressions must not overflow the stack
+    const size_t count = 20000;
+
+    std::string sum = "0";
+    for (size_t i = 0; i < count; i++)
+        sum.append("+1");
+    EXPECT_TRUE(Parser_Test(sum, double(count)));
+
+    std::string nested = std::string(count, '(') + "1" + std::string(count, ')');
+    EXPECT_TRUE(Parser_Test(nested, 1));
+}
+
+TEST(Parser, Invalid_expressions_build_nothing)
+{
+    auto language = Language::Nodable();
+    Container container(language);
+    Parser parser(language, &container);
+
+    // the Ast is validated before any node is created
+    EXPECT_FALSE(parser.eval("a + 2 * unknownFunction(b, 3)"));
+    EXPECT_FALSE(parser.eval("true + \"string\" * 2"));
+    EXPECT_EQ(container.getNodeCount(), size_t(0));
+
+    EXPECT_TRUE(parser.eval("a + 2"));
+    EXPECT_NE(container.getNodeCount(), size_t(0));
+}
+
+TEST(Parser, Optimizations)
+{
+    auto language = Language::Nodable();
+
+    auto evaluate = [&](const std::string& _expression, bool _optimize, size_t& _nodeCount) -> double
+    {
+        Container container(language);
+        Parser parser(language, &container);
+        parser.setOptimizationEnabled(_optimize);
+        EXPECT_TRUE(parser.eval(_expression));
+        container.update();
+        _nodeCount = container.getNodeCount();
+        return (double)*container.getResultVariable()->getMember();
+    };
+
+    size_t mirrored, optimized;
+
+    // constant folding: only the result variable is left
+    EXPECT_EQ(evaluate("2*(5+3)+2*(5+3)", true, optimized), 32.0);
+    EXPECT_EQ(evaluate("2*(5+3)+2*(5+3)", false, mirrored), 32.0);
+    EXPECT_EQ(optimized, size_t(1));
+    EXPECT_GT(mirrored, optimized);
+
+    // common subexpressions: a, a+1, * and the result
+    EXPECT_EQ(evaluate("(a+1)*(a+1)", true, optimized), 1.0);
+    EXPECT_EQ(optimized, size_t(4));
+
+    // assignments are never folded nor merged
+    EXPECT_EQ(evaluate("a = 2 + 3", true, optimized), 5.0);
+    EXPECT_EQ(optimized, size_t(3));
+}
+
+TEST(Parser, Programs)
+{
+    EXPECT_TRUE(Parser_Test("a = 5; b = a * 2; b + 1", 11));
+    EXPECT_TRUE(Parser_Test("a = 1; a = a + 1; a = a * 10;", 20));
+    EXPECT_TRUE(Parser_Test("s = \"a;b\"; // comment;\n s + \"c\"", "a;bc"));
+    EXPECT_TRUE(Parser_Test(";; 1 + 2 ;;", 3));
+
+    auto language = Language::Nodable();
+    Container container(language);
+    Parser parser(language, &container);
+
+    EXPECT_FALSE(parser.eval("a = 2; b = a +; 3"));
+    EXPECT_FALSE(parser.eval("a = 2 b = 3"));
+    EXPECT_FALSE(parser.eval(" ; "));
+    EXPECT_EQ(container.getNodeCount(), size_t(0));
+}
+
+TEST(Parser, Streaming)
+{
+    auto language = Language::Nodable();
+
+    // thousands of statements, each one reading the previous one
+    const size_t count = 5000;
+    std::string program = "x0 = 0;";
+    for (size_t i = 1; i <= count; i++)
+        program.append("x" + std::to_string(i) + " = x" + std::to_string(i - 1) + " + 1;\n");
+
+    for (auto streaming : {false, true})
+    {
+        Container container(language);
+        Parser parser(language, &container);
+        parser.setStreamingEnabled(streaming);
+
+        EXPECT_TRUE(parser.eval(program));
+        EXPECT_EQ(parser.getStatementCount(), count + 1);
+        container.update();
+        EXPECT_EQ((double)*container.getResultVariable()->getMember(), double(count));
+    }
+
+    // when streaming, statements before a wrong one are kept
+    Container container(language);
+    Parser parser(language, &container);
+    parser.setStreamingEnabled(true);
+    EXPECT_FALSE(parser.eval("a = 2; b = unknownFunction(a); 3"));
+    EXPECT_NE(container.getNodeCount(), size_t(0));
+}
+
+TEST(Parser, Reconciliation)
+{
+    auto language = Language::Nodable();
+    Container container(language);
+    Parser parser(language, &container);
+    parser.setReconciliationEnabled(true);
+
+    EXPECT_TRUE(parser.eval("a * 2 + sin(b)"));
+    container.findVariable("a")->set(3.0);
+    container.update();
+    EXPECT_EQ((double)*container.getResultVariable()->getMember(), 6.0);
+
+    std::vector<Node*> before = container.getEntities();
+    auto isKept = [&](Node* _node) { return std::find(before.begin(), before.end(), _node) != before.end(); };
+
+    // a, b, a * 2 and the result are kept, sin(b) is replaced by cos(b), and + by a new one.
+    EXPECT_TRUE(parser.eval("a * 2 + cos(b)"));
+    EXPECT_EQ(container.getNodeCount(), before.size());
+    EXPECT_EQ(std::count_if(container.getEntities().begin(), container.getEntities().end(), isKept), 4);
+
+    for (auto each : container.getEntities())
+    {
+        if (isKept(each) && each != container.getResultVariable())
+            EXPECT_FALSE(each->isDirty());
+    }
+
+    container.update();
+    EXPECT_EQ((double)*container.getResultVariable()->getMember(), 7.0);
+
+    // a wrong expression leaves the graph untouched
+    auto count = container.getNodeCount();
+    EXPECT_FALSE(parser.eval("a * 2 + "));
+    EXPECT_EQ(container.getNodeCount(), count);
+
+    // nodes and variables no longer used are deleted, except the ones not built by the parser
+    auto scratch = container.newVariable("scratch");
+    EXPECT_TRUE(parser.eval("1 + 1"));
+    EXPECT_EQ(container.getNodeCount(), size_t(3));
+    EXPECT_EQ(container.findVariable("a"), nullptr);
+    EXPECT_EQ(container.findVariable("scratch"), scratch);
+    container.update();
+    EXPECT_EQ((double)*container.getResultVariable()->getMember(), 2.0);
+}
+
+TEST(Parser, Reconciliation_checks_the_function_of_reused_nodes)
+{
+    auto language = Language::Nodable();
+    auto functionNode = [](Container& _container) -> Node* {
+        for (auto each : _container.getEntities())
+            if (each->getComponent<ComputeFunction>() != nullptr)
+                return each;
+        return nullptr;
+    };
+
+    // the source hash of "cos(b)"
+    Container other(language);
+    Parser otherParser(language, &other);
+    otherParser.setReconciliationEnabled(true);
+    EXPECT_TRUE(otherParser.eval("cos(b)"));
+    auto cosHash = functionNode(other)->getSourceHash();
+
+    // a hash collision between sin(b) and cos(b) must not reuse the sin node
+    Container container(language);
+    Parser parser(language, &container);
+    parser.setReconciliationEnabled(true);
+    EXPECT_TRUE(parser.eval("sin(b)"));
+    auto sinNode = functionNode(container);
+    sinNode->setSourceHash(cosHash);
+
+    EXPECT_TRUE(parser.eval("cos(b)"));
+    EXPECT_NE(functionNode(container), sinNode);
+    container.update();
+    EXPECT_EQ((double)*container.getResultVariable()->getMember(), 1.0);
+}
+
+TEST(Parser, Cache)
+{
+    auto language = Language::Nodable();
+    Parser::Cache cache(2);
+
+    auto evaluate = [&](const std::string& _expression, bool _optimize = false) -> double
+    {
+        Container container(language);
+        Parser parser(language, &container);
+        parser.setCache(&cache);
+        parser.setOptimizationEnabled(_optimize);
+        EXPECT_TRUE(parser.eval(_expression));
+        container.update();
+        return (double)*container.getResultVariable()->getMember();
+    };
+
+    // optimizations modify the Ast, not the cached one
+    EXPECT_EQ(evaluate("2*(5+3)", true), 16.0);
+    EXPECT_EQ(evaluate(std::string("2*(5+3)"), true), 16.0);
+    EXPECT_EQ(evaluate("2*(5+3)"), 16.0);
+    EXPECT_EQ(cache.getMisses(), size_t(1));
+    EXPECT_EQ(cache.getHits(), size_t(2));
+
+    // the least recently used program is dropped
+    EXPECT_EQ(evaluate("a = 1; a + 1"), 2.0);
+    EXPECT_EQ(evaluate("3"), 3.0);
+    EXPECT_EQ(cache.size(), size_t(2));
+    EXPECT_EQ(evaluate("2*(5+3)"), 16.0);
+    EXPECT_EQ(cache.getMisses(), size_t(4));
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), size_t(0));
+    EXPECT_EQ(cache.getHits(), size_t(0));
+}
+
+TEST(Parser, Int64)
+{
+    EXPECT_TRUE(Parser_Test("int(7) + int(5)", int64_t(12)));
+    EXPECT_TRUE(Parser_Test("int(7) / int(2)", int64_t(3)));
+    EXPECT_TRUE(Parser_Test("mod(int(-7), int(3))", int64_t(-1)));
+    EXPECT_TRUE(Parser_Test("int(4) * int(1000000000) * int(1000000000)", int64_t(4000000000000000000)));
+    EXPECT_TRUE(Parser_Test("int(3) > int(2)", true));
+
+    // overflows wrap around
+    EXPECT_TRUE(Parser_Test("int(9223372036854775807) + int(1)", std::numeric_limits<int64_t>::min()));
+    EXPECT_TRUE(Parser_Test("int(-9223372036854775808) - int(1)", std::numeric_limits<int64_t>::max()));
+    EXPECT_TRUE(Parser_Test("int(4611686018427387904) * int(2)", std::numeric_limits<int64_t>::min()));
+    EXPECT_TRUE(Parser_Test("-int(-9223372036854775808)", std::numeric_limits<int64_t>::min()));
+
+    // NaN and out of range numbers are clamped
+    EXPECT_TRUE(Parser_Test("int(pow(10, 300))", std::numeric_limits<int64_t>::max()));
+    EXPECT_TRUE(Parser_Test("int(-pow(10, 300))", std::numeric_limits<int64_t>::min()));
+    EXPECT_TRUE(Parser_Test("int(mod(1, 0))", int64_t(0)));
+
+    // a zero divisor, or a quotient out of range, fails without trapping (also when folded while parsing)
+    for (auto expression : {"int(7) / int(0)", "mod(int(7), int(0))",
+                            "int(-9223372036854775808) / int(-1)", "mod(int(-9223372036854775808), int(-1))"})
+    {
+        for (auto optimize : {false, true})
+        {
+            Container container(Language::Nodable());
+            Parser parser(Language::Nodable(), &container);
+            parser.setOptimizationEnabled(optimize);
+            EXPECT_TRUE(parser.eval(expression));
+            container.update();
+            EXPECT_FALSE(container.getResultVariable()->getMember()->isType(Type::Int64)) << expression;
+        }
+    }
+}
+
+TEST(Parser, Float32_comparisons)
+{
+    EXPECT_TRUE(Parser_Test("float(2) >= float(2)", true));
+    EXPECT_TRUE(Parser_Test("float(3) >= float(2.5)", true));
+    EXPECT_TRUE(Parser_Test("float(2) <= float(1)", false));
+    EXPECT_TRUE(Parser_Test("float(1.5) <= float(1.5)", true));
+    EXPECT_TRUE(Parser_Test("float(0.5) == float(0.5)", true));
+    EXPECT_TRUE(Parser_Test("float(0.5) == float(1)", false));
+}
+
+TEST(Parser, Modulo)
+{
+    EXPECT_TRUE(Parser_Test("mod(7, 4)", 3));
+    EXPECT_TRUE(Parser_Test("mod(7.5, 4)", 3));
+    EXPECT_TRUE(Parser_Test("mod(-7, 3)", -1));
+
+    // a zero divisor gives NaN, also when folded while parsing
+    for (auto optimize : {false, true})
+    {
+        Container container(Language::Nodable());
+        Parser parser(Language::Nodable(), &container);
+        parser.setOptimizationEnabled(optimize);
+        EXPECT_TRUE(parser.eval("mod(5, 0)"));
+        container.update();
+        EXPECT_TRUE(std::isnan((double)*container.getResultVariable()->getMember()));
+    }
+}
+
+TEST(Parser, Vectors)
+{
+    Vec3 expected;
+    expected[0] = 2; expected[1] = 4; expected[2] = 6;
+
+    EXPECT_TRUE(Parser_Test("vec3(1, 2, 3) * 2", expected));
+    EXPECT_TRUE(Parser_Test("vec3(1, 2, 3) + vec3(1, 2, 3)", expected));
+    EXPECT_TRUE(Parser_Test("number(length(vec2(3, 4)))", 5));
+    EXPECT_TRUE(Parser_Test("number(dot(vec4(1, 1, 1, 1), vec4(1, 2, 3, 4)))", 10));
+}
@@ -0,0 +1,35 @@
+#include "gtest/gtest.h"
+#include <Core/TaskScheduler.h>
+#include <atomic>
+
+using namespace Nodable;
+
+TEST(TaskScheduler, Wait_for_all_tasks)
+{
+    TaskScheduler scheduler(4);
+    std::atomic<int> count(0);
+
+    for (int i = 0; i < 1000; i++)
+        scheduler.spawn([&count] { count++; });
+
+    scheduler.wait();
+    EXPECT_EQ(count, 1000);
+}
+
+TEST(TaskScheduler, Wait_for_nested_tasks)
+{
+    TaskScheduler scheduler(4);
+    std::atomic<int> count(0);
+
+    for (int i = 0; i < 100; i++)
+    {
+        scheduler.spawn([&scheduler, &count] {
+            count++;
+            for (int j = 0; j < 10; j++)
+                scheduler.spawn([&count] { count++; });
+        });
+    }
+
+    scheduler.wait();
+    EXPECT_EQ(count, 100 + 100 * 10);
+}